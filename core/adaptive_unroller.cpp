@@ -38,6 +38,8 @@ UnorderedTermMap & AdaptiveUnroller::var_cache_at_time(unsigned int k)
 
   if (current_num_vars > num_vars_) {
     num_vars_ = current_num_vars;
+    // unrolled subterms might contain the new variables untimed
+    clear_subterm_cache();
     size_t t = 0;
     for (UnorderedTermMap & subst : time_cache_) {
       for (auto v : ts_.statevars()) {
@@ -0,0 +1,149 @@
+/*********************                                                        */
+/*! \file simple_path.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Lazy simple path constraints over an unrolling.
+**
+**
+**/
+
+#include "core/simple_path.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "assert.h"
+
+using namespace smt;
+using namespace std;
+
+namespace pono {
+
+SimplePathEncoder::SimplePathEncoder(const TransitionSystem & ts,
+                                     Unroller & unroller,
+                                     const SmtSolver & solver)
+    : ts_(ts), unroller_(unroller), solver_(solver)
+{
+}
+
+const TermVec & SimplePathEncoder::state(int t)
+{
+  if (statevars_.empty()) {
+    statevars_.assign(ts_.statevars().begin(), ts_.statevars().end());
+    assert(statevars_.size());
+    for (size_t k = 0; k < statevars_.size(); ++k) {
+      if (statevars_[k]->get_sort()->get_sort_kind() == ARRAY) {
+        arrays_.push_back(k);
+      }
+    }
+  }
+
+  while (states_.size() <= size_t(t)) {
+    size_t k = states_.size();
+    states_.emplace_back();
+    states_.back().reserve(statevars_.size());
+    for (const auto & v : statevars_) {
+      states_.back().push_back(unroller_.at_time(v, k));
+    }
+  }
+  return states_[t];
+}
+
+Term SimplePathEncoder::constraint(int i, int j)
+{
+  assert(i != j);
+  int lo = std::min(i, j);
+  int hi = std::max(i, j);
+  if (constraints_.size() <= size_t(hi)) {
+    constraints_.resize(hi + 1);
+  }
+  TermVec & row = constraints_[hi];
+  if (row.size() <= size_t(lo)) {
+    row.resize(lo + 1);
+  }
+
+  Term & c = row[lo];
+  if (!c) {
+    // hi first, so that state(lo) doesn't grow states_
+    const TermVec & s_hi = state(hi);
+    const TermVec & s_lo = state(lo);
+    for (size_t k = 0; k < s_lo.size(); ++k) {
+      Term eq = solver_->make_term(Equal, s_lo[k], s_hi[k]);
+      Term neq = solver_->make_term(Not, eq);
+      c = c ? solver_->make_term(Or, c, neq) : neq;
+    }
+  }
+  return c;
+}
+
+TermVec SimplePathEncoder::violated(int i)
+{
+  // the values of the state variables at each time
+  // bucketed by their hash
+  // array values are left out: equal arrays can have different
+  // values (e.g. store chains), so they are compared with the solver
+  vector<TermVec> values(i + 1);
+  unordered_map<size_t, vector<int>> buckets;
+  for (int t = 0; t <= i; ++t) {
+    const TermVec & s = state(t);
+    TermVec & vals = values[t];
+    vals.reserve(s.size());
+    size_t h = 0;
+    for (const auto & v : s) {
+      if (v->get_sort()->get_sort_kind() == ARRAY) {
+        vals.push_back(nullptr);
+        continue;
+      }
+      vals.push_back(solver_->get_value(v));
+      h ^= vals.back()->hash() + 0x9e3779b9 + (h << 6) + (h >> 2);
+    }
+    buckets[h].push_back(t);
+  }
+
+  Term true_ = arrays_.empty() ? nullptr : solver_->make_term(true);
+  auto same_state = [&](int r, int t) {
+    if (values[r] != values[t]) {
+      return false;
+    }
+    const TermVec & s_r = state(r);
+    const TermVec & s_t = state(t);
+    for (size_t k : arrays_) {
+      Term eq = solver_->make_term(Equal, s_r[k], s_t[k]);
+      if (solver_->get_value(eq) != true_) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  TermVec res;
+  for (const auto & elem : buckets) {
+    const vector<int> & times = elem.second;
+    if (times.size() < 2) {
+      continue;
+    }
+    // times with the same hash might still differ
+    // link each one to the last earlier one with the same state
+    vector<int> reps;
+    for (int t : times) {
+      auto it = std::find_if(
+          reps.begin(), reps.end(), [&](int r) { return same_state(r, t); });
+      if (it == reps.end()) {
+        reps.push_back(t);
+      } else {
+        res.push_back(constraint(*it, t));
+        *it = t;
+      }
+    }
+  }
+  return res;
+}
+
+}  // namespace pono
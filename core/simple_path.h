@@ -0,0 +1,73 @@
+/*********************                                                        */
+/*! \file simple_path.h
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Lazy simple path constraints over an unrolling.
+**
+**        Instead of checking every pair of time steps against the
+**        model (quadratic in the bound, each pair a new term over all
+**        state variables), the values of the state variables at each
+**        time step are hashed and only the time steps in the same
+**        bucket are compared. Array state variables are compared by
+**        evaluating their equality in the model instead. The constraint
+**        of a pair is built once and cached.
+**
+**/
+
+#pragma once
+
+#include <vector>
+
+#include "core/unroller.h"
+#include "smt-switch/smt.h"
+
+namespace pono {
+
+class SimplePathEncoder
+{
+ public:
+  /** @param ts the transition system
+   *  @param unroller the unroller of the engine
+   *  @param solver the solver the unrolling lives in
+   */
+  SimplePathEncoder(const TransitionSystem & ts,
+                    Unroller & unroller,
+                    const smt::SmtSolver & solver);
+
+  /** @return the constraint that the states at times i and j differ
+   *  @requires i != j and ts has state variables
+   */
+  smt::Term constraint(int i, int j);
+
+  /** Finds the time steps in 0..i with equal states in the current model
+   *  @requires the last check of the solver was sat
+   *  @param i the last time step
+   *  @return constraints that are violated by the current model: one for
+   *          each pair of consecutive time steps with the same state
+   *          (so that the model is ruled out by adding all of them)
+   */
+  smt::TermVec violated(int i);
+
+ protected:
+  const TransitionSystem & ts_;
+  Unroller & unroller_;
+  smt::SmtSolver solver_;
+
+  smt::TermVec statevars_;
+  std::vector<size_t> arrays_;  ///< indices of the array state variables
+  std::vector<smt::TermVec> states_;  ///< the state variables at time t
+  ///< constraints_[l][j] is the constraint for j < l (or null)
+  std::vector<smt::TermVec> constraints_;
+
+  /** @return the state variables at time t */
+  const smt::TermVec & state(int t);
+};
+
+}  // namespace pono
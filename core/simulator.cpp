@@ -0,0 +1,892 @@
+/*********************                                                        */
+/*! \file simulator.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Bit-parallel random simulator for functional transition systems.
+**
+**
+**/
+
+#include "core/simulator.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "utils/exceptions.h"
+#include "utils/logger.h"
+#include "utils/term_analysis.h"
+
+using namespace smt;
+using namespace std;
+
+namespace pono {
+
+// bit-sliced helpers
+// all of them work on w words where word j is bit j of every lane
+// destinations never alias the arguments
+
+static const uint64_t ALL_ONES = ~0ull;
+
+/** d = a + b + cin (cin is a lane mask) */
+static void add_words(const uint64_t * a,
+                      const uint64_t * b,
+                      uint64_t cin,
+                      uint64_t * d,
+                      size_t w,
+                      bool negate_b = false)
+{
+  uint64_t c = cin;
+  for (size_t j = 0; j < w; ++j) {
+    uint64_t bj = negate_b ? ~b[j] : b[j];
+    uint64_t s = a[j] ^ bj;
+    d[j] = s ^ c;
+    c = (a[j] & bj) | (s & c);
+  }
+}
+
+/** @return lane mask of a < b (unsigned, or signed if is_signed) */
+static uint64_t ult_words(const uint64_t * a,
+                          const uint64_t * b,
+                          size_t w,
+                          bool is_signed = false)
+{
+  // carry out of a + ~b + 1 is set iff a >= b
+  uint64_t c = ALL_ONES;
+  for (size_t j = 0; j < w; ++j) {
+    uint64_t aj = a[j];
+    uint64_t nbj = ~b[j];
+    if (is_signed && j + 1 == w) {
+      // flipping the sign bits maps signed to unsigned order
+      aj = ~aj;
+      nbj = ~nbj;
+    }
+    uint64_t s = aj ^ nbj;
+    c = (aj & nbj) | (s & c);
+  }
+  return ~c;
+}
+
+static uint64_t eq_words(const uint64_t * a, const uint64_t * b, size_t w)
+{
+  uint64_t diff = 0;
+  for (size_t j = 0; j < w; ++j) {
+    diff |= a[j] ^ b[j];
+  }
+  return ~diff;
+}
+
+/** d = c ? a : b (per lane) */
+static void mux_words(uint64_t c,
+                      const uint64_t * a,
+                      const uint64_t * b,
+                      uint64_t * d,
+                      size_t w)
+{
+  for (size_t j = 0; j < w; ++j) {
+    d[j] = (c & a[j]) | (~c & b[j]);
+  }
+}
+
+static void neg_words(const uint64_t * a, uint64_t * d, size_t w)
+{
+  vector<uint64_t> zero(w, 0);
+  add_words(zero.data(), a, ALL_ONES, d, w, true);
+}
+
+static void mul_words(const uint64_t * a,
+                      const uint64_t * b,
+                      uint64_t * d,
+                      size_t w)
+{
+  vector<uint64_t> pp(w), acc(w, 0);
+  for (size_t i = 0; i < w; ++i) {
+    // partial product (a << i) & b[i]
+    for (size_t j = 0; j < w; ++j) {
+      pp[j] = (j >= i) ? (a[j - i] & b[i]) : 0;
+    }
+    add_words(acc.data(), pp.data(), 0, d, w);
+    std::copy(d, d + w, acc.begin());
+  }
+}
+
+/** restoring division, matches SMT-LIB semantics for division by zero */
+static void udivrem_words(const uint64_t * a,
+                          const uint64_t * b,
+                          uint64_t * q,
+                          uint64_t * r,
+                          size_t w)
+{
+  vector<uint64_t> rem(w + 1, 0), bext(w + 1, 0), diff(w + 1);
+  std::copy(b, b + w, bext.begin());
+  for (size_t i = w; i-- > 0;) {
+    for (size_t j = w; j > 0; --j) {
+      rem[j] = rem[j - 1];
+    }
+    rem[0] = a[i];
+    uint64_t ge = ~ult_words(rem.data(), bext.data(), w + 1);
+    add_words(rem.data(), bext.data(), ALL_ONES, diff.data(), w + 1, true);
+    for (size_t j = 0; j <= w; ++j) {
+      rem[j] = (ge & diff[j]) | (~ge & rem[j]);
+    }
+    if (q) {
+      q[i] = ge;
+    }
+  }
+  if (r) {
+    std::copy(rem.begin(), rem.begin() + w, r);
+  }
+}
+
+/** shifts a by the amount in b
+ *  left if left, otherwise right filling with the sign bit if arith
+ */
+static void shift_words(const uint64_t * a,
+                        const uint64_t * b,
+                        uint64_t * d,
+                        size_t w,
+                        bool left,
+                        bool arith)
+{
+  vector<uint64_t> cur(a, a + w), nxt(w);
+  uint64_t fill = arith ? a[w - 1] : 0;
+  uint64_t overflow = 0;
+  for (size_t k = 0; k < w; ++k) {
+    if (k >= 63 || (1ull << k) >= w) {
+      overflow |= b[k];
+      continue;
+    }
+    size_t s = 1ull << k;
+    for (size_t j = 0; j < w; ++j) {
+      uint64_t shifted;
+      if (left) {
+        shifted = (j >= s) ? cur[j - s] : 0;
+      } else {
+        shifted = (j + s < w) ? cur[j + s] : fill;
+      }
+      nxt[j] = (b[k] & shifted) | (~b[k] & cur[j]);
+    }
+    cur.swap(nxt);
+  }
+  uint64_t over_val = left ? 0 : fill;
+  for (size_t j = 0; j < w; ++j) {
+    d[j] = (overflow & over_val) | (~overflow & cur[j]);
+  }
+}
+
+static size_t sort_width(const Sort & sort)
+{
+  SortKind sk = sort->get_sort_kind();
+  if (sk == BOOL) {
+    return 1;
+  } else if (sk == BV) {
+    return sort->get_width();
+  }
+  throw PonoException("Simulator does not support sort " + sort->to_string());
+}
+
+/** @return true for booleans, bit-vectors and arrays of those */
+static bool supported_sort(const Sort & sort)
+{
+  SortKind sk = sort->get_sort_kind();
+  if (sk == ARRAY) {
+    return supported_sort(sort->get_indexsort())
+           && supported_sort(sort->get_elemsort())
+           && sort->get_elemsort()->get_sort_kind() != ARRAY
+           && sort->get_indexsort()->get_sort_kind() != ARRAY;
+  }
+  return sk == BOOL || sk == BV;
+}
+
+// lane-local (packed) values: bit j is bit j % 64 of word j / 64
+
+static vector<uint64_t> get_lane(const uint64_t * a, size_t w, size_t lane)
+{
+  vector<uint64_t> res((w + 63) / 64, 0);
+  for (size_t j = 0; j < w; ++j) {
+    res[j / 64] |= ((a[j] >> lane) & 1ull) << (j % 64);
+  }
+  return res;
+}
+
+static void set_lane(uint64_t * d,
+                     size_t w,
+                     size_t lane,
+                     const vector<uint64_t> & val)
+{
+  uint64_t m = 1ull << lane;
+  for (size_t j = 0; j < w; ++j) {
+    uint64_t bit = (val[j / 64] >> (j % 64)) & 1ull;
+    d[j] = (d[j] & ~m) | (bit << lane);
+  }
+}
+
+static vector<uint64_t> pack(const vector<bool> & bits)
+{
+  vector<uint64_t> res((bits.size() + 63) / 64, 0);
+  for (size_t j = 0; j < bits.size(); ++j) {
+    res[j / 64] |= uint64_t(bits[j]) << (j % 64);
+  }
+  return res;
+}
+
+static Term packed_value(const SmtSolver & solver,
+                         const vector<uint64_t> & val,
+                         const Sort & sort)
+{
+  if (sort->get_sort_kind() == BOOL) {
+    return solver->make_term(bool(val[0] & 1ull));
+  }
+  size_t w = sort->get_width();
+  string bin;
+  for (size_t j = w; j-- > 0;) {
+    bin.push_back(((val[j / 64] >> (j % 64)) & 1ull) ? '1' : '0');
+  }
+  return solver->make_term(bin, sort, 2);
+}
+
+Simulator::Simulator(const TransitionSystem & ts, unsigned int seed)
+    : ts_(ts),
+      gen_(seed),
+      run_gen_(seed),
+      cycle_(0),
+      valid_(ALL_ONES),
+      exact_(true)
+{
+  if (!ts_.is_functional()) {
+    throw PonoException("Simulator requires a functional transition system");
+  }
+
+  // variables of unsupported sorts are not simulated
+  // terms containing them can't be compiled
+  auto supported = [this](const Term & v) {
+    if (supported_sort(v->get_sort())) {
+      return true;
+    }
+    exact_ = false;
+    return false;
+  };
+
+  for (const auto & v : ts_.inputvars()) {
+    if (supported(v)) {
+      alloc(v);
+      inputs_.push_back(v);
+    }
+  }
+
+  const UnorderedTermMap & updates = ts_.state_updates();
+  for (const auto & v : ts_.statevars()) {
+    if (supported(v)) {
+      alloc(v);
+    }
+  }
+
+  for (const auto & v : ts_.statevars()) {
+    if (offset_.find(v) == offset_.end()) {
+      continue;
+    }
+    auto it = updates.find(v);
+    if (it == updates.end()) {
+      inputs_.push_back(v);
+      continue;
+    }
+    try {
+      compile(it->second, tape_, compiled_);
+      statevars_.push_back(v);
+    }
+    catch (PonoException & e) {
+      logger.log(
+          2, "Simulator: treating {} as free -- {}", v->to_string(), e.what());
+      inputs_.push_back(v);
+      exact_ = false;
+    }
+  }
+
+  for (const auto & c : ts_.constraints()) {
+    try {
+      compile(c, tape_, compiled_);
+      constraints_.push_back(c);
+    }
+    catch (PonoException & e) {
+      logger.log(2, "Simulator: ignoring constraint -- {}", e.what());
+      exact_ = false;
+    }
+  }
+
+  // initial values: conjuncts of the form v = val
+  TermVec to_visit({ ts_.init() });
+  while (to_visit.size()) {
+    Term t = to_visit.back();
+    to_visit.pop_back();
+    PrimOp po = t->get_op().prim_op;
+    if (po == And) {
+      for (const auto & c : t) {
+        to_visit.push_back(c);
+      }
+    } else if (po == Equal) {
+      TermVec eq;
+      for (const auto & c : t) {
+        eq.push_back(c);
+      }
+      if (!ts_.is_curr_var(eq[0])) {
+        std::swap(eq[0], eq[1]);
+      }
+      if (!ts_.is_curr_var(eq[0]) || offset_.find(eq[0]) == offset_.end()) {
+        continue;
+      }
+      try {
+        compile(eq[1], init_tape_, init_compiled_);
+        init_vars_.push_back(eq[0]);
+        init_vals_.push_back(eq[1]);
+      }
+      catch (PonoException & e) {
+        // left random, lanes that don't satisfy init are invalid
+      }
+    }
+  }
+
+  // lanes that violate init are masked out
+  try {
+    compile(ts_.init(), init_tape_, init_compiled_);
+  }
+  catch (PonoException & e) {
+    logger.log(1, "Simulator: can't check init -- {}", e.what());
+    exact_ = false;
+  }
+}
+
+void Simulator::add_term(const Term & t)
+{
+  compile(t, tape_, compiled_);
+}
+
+void Simulator::reset()
+{
+  run_gen_ = gen_;
+  cycle_ = 0;
+  valid_ = ALL_ONES;
+
+  for (const auto & v : statevars_) {
+    randomize(v);
+  }
+  for (const auto & v : inputs_) {
+    randomize(v);
+  }
+
+  // two rounds so that initial values can refer to
+  // other initialized state variables
+  for (size_t round = 0; round < 2; ++round) {
+    run(init_tape_);
+    for (size_t i = 0; i < init_vars_.size(); ++i) {
+      assign(init_vars_[i], init_vals_[i]);
+    }
+  }
+  run(init_tape_);
+  if (init_compiled_.find(ts_.init()) != init_compiled_.end()) {
+    valid_ &= mem_[offset_.at(ts_.init())];
+  }
+
+  run(tape_);
+  for (const auto & c : constraints_) {
+    valid_ &= mem_[offset_.at(c)];
+  }
+}
+
+void Simulator::step()
+{
+  // read all the next state values before writing any of them
+  // an update can be another state variable
+  const UnorderedTermMap & updates = ts_.state_updates();
+  next_mem_.clear();
+  next_arrays_.clear();
+  for (const auto & v : statevars_) {
+    const Term & u = updates.at(v);
+    size_t off = offset_.at(u);
+    size_t w = width_.at(u);
+    if (w) {
+      next_mem_.insert(next_mem_.end(), &mem_[off], &mem_[off] + w);
+    } else {
+      next_arrays_.push_back(arrays_[off]);
+    }
+  }
+  size_t pos = 0;
+  size_t array_pos = 0;
+  for (const auto & v : statevars_) {
+    size_t off = offset_.at(v);
+    size_t w = width_.at(v);
+    if (w) {
+      std::copy(&next_mem_[pos], &next_mem_[pos] + w, &mem_[off]);
+      pos += w;
+    } else {
+      arrays_[off].swap(next_arrays_[array_pos++]);
+    }
+  }
+  for (const auto & v : inputs_) {
+    randomize(v);
+  }
+  cycle_++;
+
+  run(tape_);
+  for (const auto & c : constraints_) {
+    valid_ &= mem_[offset_.at(c)];
+  }
+}
+
+void Simulator::rewind()
+{
+  gen_ = run_gen_;
+  reset();
+}
+
+bool Simulator::has_update(const Term & v) const
+{
+  return std::find(statevars_.begin(), statevars_.end(), v)
+         != statevars_.end();
+}
+
+size_t Simulator::width(const Term & t) const
+{
+  auto it = width_.find(t);
+  if (it == width_.end()) {
+    throw PonoException("Simulator: term is not compiled " + t->to_string());
+  }
+  return it->second;
+}
+
+const uint64_t * Simulator::bits(const Term & t) const
+{
+  auto it = offset_.find(t);
+  if (it == offset_.end()) {
+    throw PonoException("Simulator: term is not compiled " + t->to_string());
+  } else if (!width_.at(t)) {
+    throw PonoException("Simulator: no bits for array " + t->to_string());
+  }
+  return &mem_[it->second];
+}
+
+Term Simulator::value(const Term & t, size_t lane) const
+{
+  auto it = offset_.find(t);
+  if (it == offset_.end()) {
+    throw PonoException("Simulator: term is not compiled " + t->to_string());
+  }
+  const SmtSolver & solver = ts_.solver();
+  Sort sort = t->get_sort();
+  size_t w = width_.at(t);
+  if (w) {
+    return packed_value(solver, get_lane(&mem_[it->second], w, lane), sort);
+  }
+
+  const ArrayLane & al = arrays_[it->second][lane];
+  Sort idxsort = sort->get_indexsort();
+  Sort elemsort = sort->get_elemsort();
+  Term res = solver->make_term(packed_value(solver, al.def, elemsort), sort);
+  for (const auto & e : al.entries) {
+    res = solver->make_term(Store,
+                            res,
+                            packed_value(solver, e.first, idxsort),
+                            packed_value(solver, e.second, elemsort));
+  }
+  return res;
+}
+
+size_t Simulator::alloc(const Term & t)
+{
+  auto it = offset_.find(t);
+  if (it != offset_.end()) {
+    return it->second;
+  }
+  Sort sort = t->get_sort();
+  if (sort->get_sort_kind() == ARRAY) {
+    if (!supported_sort(sort)) {
+      throw PonoException("Simulator does not support sort "
+                          + sort->to_string());
+    }
+    size_t ew = sort_width(sort->get_elemsort());
+    ArrayLane empty;
+    empty.def.assign((ew + 63) / 64, 0);
+    size_t idx = arrays_.size();
+    arrays_.push_back(ArrayVal(num_lanes, empty));
+    offset_[t] = idx;
+    width_[t] = 0;
+    return idx;
+  }
+
+  size_t w = sort_width(sort);
+  size_t off = mem_.size();
+  mem_.resize(off + w, 0);
+  offset_[t] = off;
+  width_[t] = w;
+  return off;
+}
+
+void Simulator::compile(const Term & t, Tape & tape, UnorderedTermSet & compiled)
+{
+  TermVec to_visit({ t });
+  UnorderedTermSet visited;
+  while (to_visit.size()) {
+    Term n = to_visit.back();
+
+    if (compiled.find(n) != compiled.end()) {
+      to_visit.pop_back();
+      continue;
+    }
+
+    if (n->is_symbolic_const()) {
+      if (offset_.find(n) == offset_.end()) {
+        throw PonoException("Simulator: unknown symbol " + n->to_string());
+      }
+      compiled.insert(n);
+      to_visit.pop_back();
+      continue;
+    }
+
+    if (n->get_sort()->get_sort_kind() == ARRAY && n->get_op().is_null()) {
+      // constant array, its only child is the element
+      if (offset_.find(n) == offset_.end()) {
+        if (n->begin() == n->end() || !(*n->begin())->is_value()) {
+          throw PonoException("Simulator: can't compile " + n->to_string());
+        }
+        Term elem = *n->begin();
+        vector<uint64_t> def =
+            pack(value_bits(elem, sort_width(elem->get_sort())));
+        size_t idx = alloc(n);
+        for (auto & al : arrays_[idx]) {
+          al.def = def;
+        }
+      }
+      compiled.insert(n);
+      to_visit.pop_back();
+      continue;
+    }
+
+    if (n->is_value()) {
+      if (offset_.find(n) == offset_.end()) {
+        size_t w = sort_width(n->get_sort());
+        vector<bool> vb = value_bits(n, w);
+        size_t off = alloc(n);
+        for (size_t j = 0; j < w; ++j) {
+          mem_[off + j] = vb[j] ? ALL_ONES : 0;
+        }
+      }
+      compiled.insert(n);
+      to_visit.pop_back();
+      continue;
+    }
+
+    Op op = n->get_op();
+    if (op.is_null()) {
+      throw PonoException("Simulator: can't compile " + n->to_string());
+    }
+
+    if (visited.insert(n).second) {
+      for (const auto & c : n) {
+        to_visit.push_back(c);
+      }
+      continue;
+    }
+
+    to_visit.pop_back();
+    Instr ins;
+    ins.op = op;
+    for (const auto & c : n) {
+      ins.args.push_back(offset_.at(c));
+      ins.arg_widths.push_back(width_.at(c));
+    }
+    if (ins.args.empty()) {
+      throw PonoException("Simulator: can't compile " + n->to_string());
+    }
+    ins.dst = alloc(n);
+    ins.width = width_.at(n);
+    ins.array = !ins.width
+                || std::find(ins.arg_widths.begin(), ins.arg_widths.end(), 0)
+                       != ins.arg_widths.end();
+    // throws for unsupported operators
+    exec(ins);
+    tape.push_back(ins);
+    compiled.insert(n);
+  }
+}
+
+void Simulator::run(const Tape & tape)
+{
+  for (const auto & ins : tape) {
+    exec(ins);
+  }
+}
+
+void Simulator::exec(const Instr & ins)
+{
+  if (ins.array) {
+    exec_array(ins);
+    return;
+  }
+
+  uint64_t * d = &mem_[ins.dst];
+  const size_t w = ins.width;
+  const size_t n = ins.args.size();
+  auto arg = [this, &ins](size_t i) -> const uint64_t * {
+    return &mem_[ins.args[i]];
+  };
+  const size_t aw = ins.arg_widths[0];
+
+  switch (ins.op.prim_op) {
+    case Not:
+    case BVNot:
+      for (size_t j = 0; j < w; ++j) {
+        d[j] = ~arg(0)[j];
+      }
+      break;
+    case And:
+    case BVAnd:
+    case Or:
+    case BVOr:
+    case Xor:
+    case BVXor: {
+      PrimOp po = ins.op.prim_op;
+      std::copy(arg(0), arg(0) + w, d);
+      for (size_t i = 1; i < n; ++i) {
+        const uint64_t * a = arg(i);
+        for (size_t j = 0; j < w; ++j) {
+          if (po == And || po == BVAnd) {
+            d[j] &= a[j];
+          } else if (po == Or || po == BVOr) {
+            d[j] |= a[j];
+          } else {
+            d[j] ^= a[j];
+          }
+        }
+      }
+      break;
+    }
+    case BVNand:
+    case BVNor:
+    case BVXnor: {
+      PrimOp po = ins.op.prim_op;
+      for (size_t j = 0; j < w; ++j) {
+        uint64_t a = arg(0)[j];
+        uint64_t b = arg(1)[j];
+        d[j] = (po == BVNand) ? ~(a & b) : (po == BVNor) ? ~(a | b) : ~(a ^ b);
+      }
+      break;
+    }
+    case Implies: d[0] = ~arg(0)[0] | arg(1)[0]; break;
+    case Equal:
+    case BVComp: d[0] = eq_words(arg(0), arg(1), aw); break;
+    case Distinct: d[0] = ~eq_words(arg(0), arg(1), aw); break;
+    case Ite: mux_words(arg(0)[0], arg(1), arg(2), d, w); break;
+    case BVAdd: {
+      add_words(arg(0), arg(1), 0, d, w);
+      vector<uint64_t> acc;
+      for (size_t i = 2; i < n; ++i) {
+        acc.assign(d, d + w);
+        add_words(acc.data(), arg(i), 0, d, w);
+      }
+      break;
+    }
+    case BVSub: add_words(arg(0), arg(1), ALL_ONES, d, w, true); break;
+    case BVNeg: neg_words(arg(0), d, w); break;
+    case BVMul: {
+      mul_words(arg(0), arg(1), d, w);
+      vector<uint64_t> acc;
+      for (size_t i = 2; i < n; ++i) {
+        acc.assign(d, d + w);
+        mul_words(acc.data(), arg(i), d, w);
+      }
+      break;
+    }
+    case BVUdiv: udivrem_words(arg(0), arg(1), d, nullptr, w); break;
+    case BVUrem: udivrem_words(arg(0), arg(1), nullptr, d, w); break;
+    case BVSdiv:
+    case BVSrem:
+    case BVSmod: {
+      PrimOp po = ins.op.prim_op;
+      const uint64_t * a = arg(0);
+      const uint64_t * b = arg(1);
+      uint64_t sa = a[w - 1];
+      uint64_t sb = b[w - 1];
+      vector<uint64_t> na(w), nb(w), abs_a(w), abs_b(w), res(w), nres(w);
+      neg_words(a, na.data(), w);
+      neg_words(b, nb.data(), w);
+      mux_words(sa, na.data(), a, abs_a.data(), w);
+      mux_words(sb, nb.data(), b, abs_b.data(), w);
+      if (po == BVSdiv) {
+        udivrem_words(abs_a.data(), abs_b.data(), res.data(), nullptr, w);
+        neg_words(res.data(), nres.data(), w);
+        mux_words(sa ^ sb, nres.data(), res.data(), d, w);
+      } else {
+        udivrem_words(abs_a.data(), abs_b.data(), nullptr, res.data(), w);
+        neg_words(res.data(), nres.data(), w);
+        if (po == BVSrem) {
+          // sign follows the dividend
+          mux_words(sa, nres.data(), res.data(), d, w);
+        } else {
+          // sign follows the divisor
+          vector<uint64_t> zero(w, 0), t1(w), t2(w);
+          uint64_t is_zero = eq_words(res.data(), zero.data(), w);
+          add_words(nres.data(), b, 0, t1.data(), w);
+          add_words(res.data(), b, 0, t2.data(), w);
+          for (size_t j = 0; j < w; ++j) {
+            uint64_t v = (~sa & ~sb & res[j]) | (sa & ~sb & t1[j])
+                         | (~sa & sb & t2[j]) | (sa & sb & nres[j]);
+            d[j] = (is_zero & res[j]) | (~is_zero & v);
+          }
+        }
+      }
+      break;
+    }
+    case BVShl: shift_words(arg(0), arg(1), d, w, true, false); break;
+    case BVLshr: shift_words(arg(0), arg(1), d, w, false, false); break;
+    case BVAshr: shift_words(arg(0), arg(1), d, w, false, true); break;
+    case BVUlt: d[0] = ult_words(arg(0), arg(1), aw); break;
+    case BVUle: d[0] = ~ult_words(arg(1), arg(0), aw); break;
+    case BVUgt: d[0] = ult_words(arg(1), arg(0), aw); break;
+    case BVUge: d[0] = ~ult_words(arg(0), arg(1), aw); break;
+    case BVSlt: d[0] = ult_words(arg(0), arg(1), aw, true); break;
+    case BVSle: d[0] = ~ult_words(arg(1), arg(0), aw, true); break;
+    case BVSgt: d[0] = ult_words(arg(1), arg(0), aw, true); break;
+    case BVSge: d[0] = ~ult_words(arg(0), arg(1), aw, true); break;
+    case Concat: {
+      // the first argument is the most significant
+      size_t j = w;
+      for (size_t i = 0; i < n; ++i) {
+        j -= ins.arg_widths[i];
+        std::copy(arg(i), arg(i) + ins.arg_widths[i], d + j);
+      }
+      assert(j == 0);
+      break;
+    }
+    case Extract: std::copy(arg(0) + ins.op.idx1, arg(0) + ins.op.idx0 + 1, d);
+      break;
+    case Zero_Extend:
+    case Sign_Extend: {
+      uint64_t fill = (ins.op.prim_op == Sign_Extend) ? arg(0)[aw - 1] : 0;
+      std::copy(arg(0), arg(0) + aw, d);
+      std::fill(d + aw, d + w, fill);
+      break;
+    }
+    case Repeat:
+      for (size_t j = 0; j < w; ++j) {
+        d[j] = arg(0)[j % aw];
+      }
+      break;
+    case Rotate_Left:
+      for (size_t j = 0; j < w; ++j) {
+        d[(j + ins.op.idx0) % w] = arg(0)[j];
+      }
+      break;
+    case Rotate_Right:
+      for (size_t j = 0; j < w; ++j) {
+        d[j] = arg(0)[(j + ins.op.idx0) % w];
+      }
+      break;
+    default:
+      throw PonoException("Simulator does not support operator "
+                          + ins.op.to_string());
+  }
+}
+
+void Simulator::exec_array(const Instr & ins)
+{
+  PrimOp po = ins.op.prim_op;
+  switch (po) {
+    case Select: {
+      const ArrayVal & a = arrays_[ins.args[0]];
+      const uint64_t * idx = &mem_[ins.args[1]];
+      uint64_t * d = &mem_[ins.dst];
+      for (size_t l = 0; l < num_lanes; ++l) {
+        const ArrayLane & al = a[l];
+        auto it = al.entries.find(get_lane(idx, ins.arg_widths[1], l));
+        set_lane(d, ins.width, l, it == al.entries.end() ? al.def : it->second);
+      }
+      break;
+    }
+    case Store: {
+      ArrayVal res = arrays_[ins.args[0]];
+      const uint64_t * idx = &mem_[ins.args[1]];
+      const uint64_t * elem = &mem_[ins.args[2]];
+      for (size_t l = 0; l < num_lanes; ++l) {
+        ArrayLane & al = res[l];
+        Packed key = get_lane(idx, ins.arg_widths[1], l);
+        Packed val = get_lane(elem, ins.arg_widths[2], l);
+        if (val == al.def) {
+          al.entries.erase(key);
+        } else {
+          al.entries[key] = val;
+        }
+      }
+      arrays_[ins.dst].swap(res);
+      break;
+    }
+    case Ite: {
+      uint64_t c = mem_[ins.args[0]];
+      const ArrayVal & a = arrays_[ins.args[1]];
+      const ArrayVal & b = arrays_[ins.args[2]];
+      ArrayVal res(num_lanes);
+      for (size_t l = 0; l < num_lanes; ++l) {
+        res[l] = ((c >> l) & 1ull) ? a[l] : b[l];
+      }
+      arrays_[ins.dst].swap(res);
+      break;
+    }
+    case Equal:
+    case Distinct: {
+      const ArrayVal & a = arrays_[ins.args[0]];
+      const ArrayVal & b = arrays_[ins.args[1]];
+      uint64_t eq = 0;
+      for (size_t l = 0; l < num_lanes; ++l) {
+        eq |= uint64_t(a[l] == b[l]) << l;
+      }
+      mem_[ins.dst] = (po == Equal) ? eq : ~eq;
+      break;
+    }
+    default:
+      throw PonoException("Simulator does not support operator "
+                          + ins.op.to_string() + " on arrays");
+  }
+}
+
+void Simulator::randomize(const Term & v)
+{
+  size_t off = offset_.at(v);
+  size_t w = width_.at(v);
+  for (size_t j = 0; j < w; ++j) {
+    mem_[off + j] = gen_();
+  }
+  if (w) {
+    return;
+  }
+
+  size_t ew = sort_width(v->get_sort()->get_elemsort());
+  for (auto & al : arrays_[off]) {
+    for (auto & word : al.def) {
+      word = gen_();
+    }
+    if (ew % 64) {
+      al.def.back() &= (1ull << (ew % 64)) - 1;
+    }
+    al.entries.clear();
+  }
+}
+
+void Simulator::assign(const Term & dst, const Term & src)
+{
+  size_t src_off = offset_.at(src);
+  size_t dst_off = offset_.at(dst);
+  size_t w = width_.at(dst);
+  if (!w) {
+    arrays_[dst_off] = arrays_[src_off];
+    return;
+  }
+  for (size_t j = 0; j < w; ++j) {
+    mem_[dst_off + j] = mem_[src_off + j];
+  }
+}
+
+}  // namespace pono
@@ -0,0 +1,204 @@
+/*********************                                                        */
+/*! \file simulator.h
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Bit-parallel random simulator for functional transition systems.
+**
+**        Terms are compiled into a flat instruction tape. Values are
+**        bit-sliced: a term of width w is stored as w machine words and
+**        bit l of word j is bit j of the value in lane l. Thus every
+**        instruction evaluates num_lanes stimuli at once, for any
+**        bit-vector width. Arrays are kept per lane as a default
+**        element plus the indices that differ from it.
+**
+**/
+
+#pragma once
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include "core/ts.h"
+
+namespace pono {
+
+class Simulator
+{
+ public:
+  /** number of stimuli evaluated in parallel */
+  static const size_t num_lanes = 64;
+
+  /** Compiles the state updates of ts
+   *  State variables without a supported update function (or without any
+   *  update) are treated like inputs and take random values every cycle.
+   *  @param ts the functional transition system to simulate
+   *  @param seed the seed for the random stimuli
+   */
+  Simulator(const TransitionSystem & ts, unsigned int seed = 0);
+
+  /** Compiles a term over current state variables and inputs
+   *  so that it is evaluated every cycle
+   *  @param t the term to evaluate
+   *  throws a PonoException if t contains unsupported operators
+   */
+  void add_term(const smt::Term & t);
+
+  /** Starts a new run in all lanes
+   *  State variables get their initial value (random if unconstrained)
+   *  and inputs are randomized.
+   */
+  void reset();
+
+  /** Advances all lanes by one cycle with random inputs */
+  void step();
+
+  /** Restarts the current run from the beginning
+   *  with the same stimuli as the last reset
+   *  e.g. to extract the values of a lane at an earlier cycle
+   */
+  void rewind();
+
+  /** @return the number of cycles since the last reset */
+  size_t cycle() const { return cycle_; }
+
+  /** @return mask of the lanes that satisfy init and all constraints
+   *          since the last reset
+   */
+  uint64_t valid_lanes() const { return valid_; }
+
+  /** @return true iff every variable, state update, constraint and init
+   *          could be compiled, i.e. every valid lane is an execution
+   *          of the transition system
+   */
+  bool exact() const { return exact_; }
+
+  /** @return true iff v is a state variable with a compiled update */
+  bool has_update(const smt::Term & v) const;
+
+  /** @return the width (number of words) of a compiled term
+   *          or 0 for arrays
+   */
+  size_t width(const smt::Term & t) const;
+
+  /** Get the current value of a compiled term
+   *  @param t a state variable, input or a term given to add_term
+   *         (not an array)
+   *  @return pointer to width(t) words, word j holds bit j for all lanes
+   */
+  const uint64_t * bits(const smt::Term & t) const;
+
+  /** Get the current value of a compiled term in one lane
+   *  @param t a state variable, input or a term given to add_term
+   *  @param lane the lane
+   *  @return the value as a term of the transition system's solver
+   *          (arrays are a chain of stores on a constant array)
+   */
+  smt::Term value(const smt::Term & t, size_t lane) const;
+
+ protected:
+  /** One instruction of the tape
+   *  evaluates op(args) into mem_[dst ... dst + width)
+   *  array operands (width 0) are indices into arrays_ instead
+   */
+  struct Instr
+  {
+    smt::Op op;
+    size_t dst;
+    size_t width;
+    std::vector<size_t> args;
+    std::vector<size_t> arg_widths;
+    bool array;  ///< true iff the result or an argument is an array
+  };
+
+  typedef std::vector<Instr> Tape;
+
+  /** A value in a single lane, bit j is bit j % 64 of word j / 64 */
+  typedef std::vector<uint64_t> Packed;
+
+  /** The value of an array in a single lane
+   *  every index that is not in entries maps to def
+   *  entries never maps an index to def, so equal arrays are equal here
+   */
+  struct ArrayLane
+  {
+    Packed def;
+    std::map<Packed, Packed> entries;
+
+    bool operator==(const ArrayLane & other) const
+    {
+      return def == other.def && entries == other.entries;
+    }
+  };
+
+  typedef std::vector<ArrayLane> ArrayVal;  ///< one per lane
+
+  /** Allocates a slot for term t
+   *  @return the offset of the slot in mem_ (or the index in arrays_
+   *          for arrays)
+   */
+  size_t alloc(const smt::Term & t);
+
+  /** Compile t and its subterms (if not yet compiled) onto tape
+   *  @param t the term to compile
+   *  @param tape the tape to append instructions to
+   *  @param compiled the terms already on tape
+   */
+  void compile(const smt::Term & t,
+               Tape & tape,
+               smt::UnorderedTermSet & compiled);
+
+  /** Executes every instruction of the tape in order */
+  void run(const Tape & tape);
+
+  void exec(const Instr & ins);
+
+  /** Executes an instruction on arrays (Select, Store, Ite, Equal) */
+  void exec_array(const Instr & ins);
+
+  /** Fills the slot of a variable with random bits
+   *  arrays become a random constant array in every lane
+   */
+  void randomize(const smt::Term & v);
+
+  /** Copies the value of src into the slot of dst (of the same sort) */
+  void assign(const smt::Term & dst, const smt::Term & src);
+
+  const TransitionSystem & ts_;
+  std::mt19937_64 gen_;
+
+  std::mt19937_64 run_gen_;  ///< state of gen_ at the last reset
+
+  std::vector<uint64_t> mem_;  ///< all values, bit-sliced
+  std::vector<ArrayVal> arrays_;  ///< all array values
+  std::unordered_map<smt::Term, size_t> offset_;
+  std::unordered_map<smt::Term, size_t> width_;
+
+  Tape init_tape_;  ///< evaluates initial values and init
+  smt::UnorderedTermSet init_compiled_;
+  Tape tape_;  ///< evaluates the updates, constraints and added terms
+  smt::UnorderedTermSet compiled_;
+
+  smt::TermVec inputs_;      ///< inputs and state vars without update
+  smt::TermVec statevars_;   ///< state vars with a compiled update
+  smt::TermVec init_vars_;   ///< state vars assigned a value in init
+  smt::TermVec init_vals_;   ///< init_vals_[i] is the value of init_vars_[i]
+  smt::TermVec constraints_;
+
+  size_t cycle_;
+  uint64_t valid_;
+  bool exact_;
+
+  // buffers for the next state, so that updates can refer to state vars
+  std::vector<uint64_t> next_mem_;
+  std::vector<ArrayVal> next_arrays_;
+};
+
+}  // namespace pono
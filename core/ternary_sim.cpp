@@ -0,0 +1,548 @@
+/*********************                                                        */
+/*! \file ternary_sim.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Ternary (0/1/X) simulator for functional transition systems.
+**
+**
+**/
+
+#include "core/ternary_sim.h"
+
+#include <algorithm>
+#include <cassert>
+#include <unordered_set>
+
+#include "utils/exceptions.h"
+#include "utils/term_analysis.h"
+
+using namespace smt;
+using namespace std;
+
+namespace pono {
+
+typedef TernarySimulator::Trit Trit;
+
+// ternary helpers
+// a result is only ZERO or ONE if it is for every value of the X arguments
+
+static const Trit T0 = TernarySimulator::ZERO;
+static const Trit T1 = TernarySimulator::ONE;
+static const Trit TX = TernarySimulator::X;
+
+static Trit t_not(Trit a) { return (a == TX) ? TX : Trit(1 - a); }
+
+static Trit t_and(Trit a, Trit b)
+{
+  if (a == T0 || b == T0) {
+    return T0;
+  }
+  return (a == T1 && b == T1) ? T1 : TX;
+}
+
+static Trit t_or(Trit a, Trit b)
+{
+  if (a == T1 || b == T1) {
+    return T1;
+  }
+  return (a == T0 && b == T0) ? T0 : TX;
+}
+
+static Trit t_xor(Trit a, Trit b)
+{
+  return (a == TX || b == TX) ? TX : Trit(a ^ b);
+}
+
+static Trit t_ite(Trit c, Trit a, Trit b)
+{
+  if (c == T1) {
+    return a;
+  } else if (c == T0) {
+    return b;
+  }
+  return (a == b) ? a : TX;
+}
+
+/** d = a + b + cin (b negated if negate_b)
+ *  @return the carry out
+ */
+static Trit add_trits(const Trit * a,
+                      const Trit * b,
+                      Trit cin,
+                      Trit * d,
+                      size_t w,
+                      bool negate_b = false)
+{
+  Trit c = cin;
+  for (size_t j = 0; j < w; ++j) {
+    Trit bj = negate_b ? t_not(b[j]) : b[j];
+    Trit s = t_xor(a[j], bj);
+    d[j] = t_xor(s, c);
+    c = t_or(t_and(a[j], bj), t_and(s, c));
+  }
+  return c;
+}
+
+/** @return a < b (unsigned, or signed if is_signed) */
+static Trit ult_trits(const Trit * a,
+                      const Trit * b,
+                      size_t w,
+                      bool is_signed = false)
+{
+  // carry out of a + ~b + 1 is set iff a >= b
+  vector<Trit> aa(a, a + w), bb(b, b + w), d(w);
+  if (is_signed) {
+    // flipping the sign bits maps signed to unsigned order
+    aa[w - 1] = t_not(aa[w - 1]);
+    bb[w - 1] = t_not(bb[w - 1]);
+  }
+  return t_not(add_trits(aa.data(), bb.data(), T1, d.data(), w, true));
+}
+
+static Trit eq_trits(const Trit * a, const Trit * b, size_t w)
+{
+  Trit res = T1;
+  for (size_t j = 0; j < w; ++j) {
+    if (a[j] == TX || b[j] == TX) {
+      res = TX;
+    } else if (a[j] != b[j]) {
+      return T0;
+    }
+  }
+  return res;
+}
+
+static void mul_trits(const Trit * a, const Trit * b, Trit * d, size_t w)
+{
+  vector<Trit> pp(w), acc(w, T0);
+  for (size_t i = 0; i < w; ++i) {
+    // partial product (a << i) & b[i]
+    for (size_t j = 0; j < w; ++j) {
+      pp[j] = (j >= i) ? t_and(a[j - i], b[i]) : T0;
+    }
+    add_trits(acc.data(), pp.data(), T0, d, w);
+    std::copy(d, d + w, acc.begin());
+  }
+}
+
+/** barrel shifter, a is shifted by the amount in b
+ *  left if left, otherwise right filling with the sign bit if arith
+ */
+static void shift_trits(const Trit * a,
+                        const Trit * b,
+                        Trit * d,
+                        size_t w,
+                        bool left,
+                        bool arith)
+{
+  vector<Trit> cur(a, a + w), nxt(w);
+  Trit fill = arith ? a[w - 1] : T0;
+  Trit overflow = T0;
+  for (size_t k = 0; k < w; ++k) {
+    if (k >= 63 || (1ull << k) >= w) {
+      overflow = t_or(overflow, b[k]);
+      continue;
+    }
+    size_t s = 1ull << k;
+    for (size_t j = 0; j < w; ++j) {
+      Trit shifted;
+      if (left) {
+        shifted = (j >= s) ? cur[j - s] : T0;
+      } else {
+        shifted = (j + s < w) ? cur[j + s] : fill;
+      }
+      nxt[j] = t_ite(b[k], shifted, cur[j]);
+    }
+    cur.swap(nxt);
+  }
+  Trit over_val = left ? T0 : fill;
+  for (size_t j = 0; j < w; ++j) {
+    d[j] = t_ite(overflow, over_val, cur[j]);
+  }
+}
+
+/** @return the number of bits of sort, 0 if it is not supported */
+static size_t trit_width(const Sort & sort)
+{
+  SortKind sk = sort->get_sort_kind();
+  if (sk == BOOL) {
+    return 1;
+  } else if (sk == BV) {
+    return sort->get_width();
+  }
+  return 0;
+}
+
+// other operators (e.g. division, arrays) evaluate to X
+static const unordered_set<PrimOp> supported_ops(
+    { Not,         BVNot,        And,        BVAnd,       Or,
+      BVOr,        Xor,          BVXor,      BVNand,      BVNor,
+      BVXnor,      Implies,      Equal,      BVComp,      Distinct,
+      Ite,         BVAdd,        BVSub,      BVNeg,       BVMul,
+      BVShl,       BVLshr,       BVAshr,     BVUlt,       BVUle,
+      BVUgt,       BVUge,        BVSlt,      BVSle,       BVSgt,
+      BVSge,       Concat,       Extract,    Zero_Extend, Sign_Extend,
+      Repeat,      Rotate_Left,  Rotate_Right });
+
+TernarySimulator::TernarySimulator(const TransitionSystem & ts)
+    : ts_(ts), epoch_(1)
+{
+  if (!ts_.is_functional()) {
+    throw PonoException(
+        "Ternary simulation requires a functional transition system");
+  }
+}
+
+void TernarySimulator::assign(const Term & v, const Term & val)
+{
+  const Node & node = nodes_[compile(v, false)];
+  if (!node.width) {
+    return;
+  }
+  vector<bool> bits = value_bits(val, node.width);
+  for (size_t j = 0; j < node.width; ++j) {
+    mem_[node.offset + j] = bits[j] ? T1 : T0;
+  }
+  epoch_++;
+}
+
+void TernarySimulator::unassign(const Term & v)
+{
+  const Node & node = nodes_[compile(v, false)];
+  auto begin = mem_.begin() + node.offset;
+  std::fill(begin, begin + node.width, TX);
+  epoch_++;
+}
+
+Trit TernarySimulator::eval(const Term & t, bool next)
+{
+  vector<Trit> bits = eval_bits(t, next);
+  if (bits.size() != 1) {
+    throw PonoException("Ternary simulation expects a boolean term "
+                        + t->to_string());
+  }
+  return bits[0];
+}
+
+vector<Trit> TernarySimulator::eval_bits(const Term & t, bool next)
+{
+  size_t n = compile(t, next);
+  eval_node(n);
+  const Node & node = nodes_[n];
+  auto begin = mem_.begin() + node.offset;
+  return vector<Trit>(begin, begin + node.width);
+}
+
+bool TernarySimulator::lift(const TermVec & vars,
+                            const Term & target,
+                            bool next,
+                            TermVec & needed)
+{
+  needed.clear();
+  if (eval(target, next) != T1) {
+    return false;
+  }
+
+  size_t n = node_of_[next].at(target);
+  vector<Trit> saved;
+  for (const auto & v : vars) {
+    const Node & vn = nodes_[compile(v, false)];
+    saved.assign(mem_.begin() + vn.offset,
+                 mem_.begin() + vn.offset + vn.width);
+    unassign(v);
+    eval_node(n);
+    if (mem_[nodes_[n].offset] != T1) {
+      // v is needed, restore it
+      std::copy(saved.begin(), saved.end(), mem_.begin() + vn.offset);
+      epoch_++;
+      needed.push_back(v);
+    }
+  }
+  return true;
+}
+
+size_t TernarySimulator::make_leaf(size_t w)
+{
+  Node node;
+  node.offset = mem_.size();
+  node.width = w;
+  node.leaf = true;
+  mem_.resize(mem_.size() + w, TX);
+  nodes_.push_back(node);
+  stamp_.push_back(0);
+  return nodes_.size() - 1;
+}
+
+size_t TernarySimulator::compile(const Term & t, bool next)
+{
+  unordered_map<Term, size_t> & node_of = node_of_[next];
+  const UnorderedTermMap & updates = ts_.state_updates();
+
+  TermVec to_visit({ t });
+  UnorderedTermSet visited;
+  while (to_visit.size()) {
+    Term n = to_visit.back();
+    if (node_of.find(n) != node_of.end()) {
+      to_visit.pop_back();
+      continue;
+    }
+
+    size_t w = trit_width(n->get_sort());
+    if (n->is_symbolic_const()) {
+      auto it = updates.find(n);
+      if (!next) {
+        node_of[n] = make_leaf(w);
+      } else if (it != updates.end()) {
+        // the update is over the current state
+        node_of[n] = compile(it->second, false);
+      } else {
+        // inputs and state variables without update are unconstrained
+        node_of[n] = make_leaf(w);
+      }
+      to_visit.pop_back();
+      continue;
+    }
+
+    if (n->is_value()) {
+      size_t idx = make_leaf(w);
+      if (w) {
+        vector<bool> bits = value_bits(n, w);
+        for (size_t j = 0; j < w; ++j) {
+          mem_[nodes_[idx].offset + j] = bits[j] ? T1 : T0;
+        }
+      }
+      node_of[n] = idx;
+      to_visit.pop_back();
+      continue;
+    }
+
+    Op op = n->get_op();
+    if (!w || op.is_null()
+        || supported_ops.find(op.prim_op) == supported_ops.end()) {
+      node_of[n] = make_leaf(w);
+      to_visit.pop_back();
+      continue;
+    }
+
+    if (visited.insert(n).second) {
+      for (const auto & c : n) {
+        to_visit.push_back(c);
+      }
+      continue;
+    }
+
+    to_visit.pop_back();
+    Node node;
+    node.op = op;
+    node.width = w;
+    node.leaf = false;
+    for (const auto & c : n) {
+      size_t a = node_of.at(c);
+      if (!nodes_[a].width) {
+        // can't reason about arguments of unsupported sorts
+        node.leaf = true;
+      }
+      node.args.push_back(a);
+    }
+    if (node.leaf) {
+      node_of[n] = make_leaf(w);
+      continue;
+    }
+    node.offset = mem_.size();
+    mem_.resize(mem_.size() + w, TX);
+    nodes_.push_back(node);
+    stamp_.push_back(0);
+    node_of[n] = nodes_.size() - 1;
+  }
+  return node_of.at(t);
+}
+
+void TernarySimulator::eval_node(size_t n)
+{
+  vector<size_t> to_visit({ n });
+  while (to_visit.size()) {
+    size_t cur = to_visit.back();
+    const Node & node = nodes_[cur];
+    if (node.leaf || stamp_[cur] == epoch_) {
+      to_visit.pop_back();
+      continue;
+    }
+
+    bool ready = true;
+    for (auto a : node.args) {
+      if (!nodes_[a].leaf && stamp_[a] != epoch_) {
+        to_visit.push_back(a);
+        ready = false;
+      }
+    }
+    if (ready) {
+      to_visit.pop_back();
+      exec(node);
+      stamp_[cur] = epoch_;
+    }
+  }
+}
+
+void TernarySimulator::exec(const Node & node)
+{
+  Trit * d = &mem_[node.offset];
+  const size_t w = node.width;
+  const size_t n = node.args.size();
+  auto arg = [this, &node](size_t i) -> const Trit * {
+    return &mem_[nodes_[node.args[i]].offset];
+  };
+  auto arg_width = [this, &node](size_t i) {
+    return nodes_[node.args[i]].width;
+  };
+  const size_t aw = arg_width(0);
+
+  switch (node.op.prim_op) {
+    case Not:
+    case BVNot:
+      for (size_t j = 0; j < w; ++j) {
+        d[j] = t_not(arg(0)[j]);
+      }
+      break;
+    case And:
+    case BVAnd:
+    case Or:
+    case BVOr:
+    case Xor:
+    case BVXor: {
+      PrimOp po = node.op.prim_op;
+      std::copy(arg(0), arg(0) + w, d);
+      for (size_t i = 1; i < n; ++i) {
+        const Trit * a = arg(i);
+        for (size_t j = 0; j < w; ++j) {
+          if (po == And || po == BVAnd) {
+            d[j] = t_and(d[j], a[j]);
+          } else if (po == Or || po == BVOr) {
+            d[j] = t_or(d[j], a[j]);
+          } else {
+            d[j] = t_xor(d[j], a[j]);
+          }
+        }
+      }
+      break;
+    }
+    case BVNand:
+    case BVNor:
+    case BVXnor: {
+      PrimOp po = node.op.prim_op;
+      for (size_t j = 0; j < w; ++j) {
+        Trit a = arg(0)[j];
+        Trit b = arg(1)[j];
+        d[j] = t_not((po == BVNand) ? t_and(a, b)
+                     : (po == BVNor) ? t_or(a, b)
+                                     : t_xor(a, b));
+      }
+      break;
+    }
+    case Implies: d[0] = t_or(t_not(arg(0)[0]), arg(1)[0]); break;
+    case Equal:
+    case BVComp:
+      // n-ary equality: every argument equals the next one
+      d[0] = T1;
+      for (size_t i = 1; i < n; ++i) {
+        d[0] = t_and(d[0], eq_trits(arg(i - 1), arg(i), aw));
+      }
+      break;
+    case Distinct:
+      // n-ary distinct: every pair of arguments differs
+      d[0] = T1;
+      for (size_t i = 0; i < n; ++i) {
+        for (size_t l = i + 1; l < n; ++l) {
+          d[0] = t_and(d[0], t_not(eq_trits(arg(i), arg(l), aw)));
+        }
+      }
+      break;
+    case Ite:
+      for (size_t j = 0; j < w; ++j) {
+        d[j] = t_ite(arg(0)[0], arg(1)[j], arg(2)[j]);
+      }
+      break;
+    case BVAdd: {
+      add_trits(arg(0), arg(1), T0, d, w);
+      vector<Trit> acc;
+      for (size_t i = 2; i < n; ++i) {
+        acc.assign(d, d + w);
+        add_trits(acc.data(), arg(i), T0, d, w);
+      }
+      break;
+    }
+    case BVSub: add_trits(arg(0), arg(1), T1, d, w, true); break;
+    case BVNeg: {
+      vector<Trit> zero(w, T0);
+      add_trits(zero.data(), arg(0), T1, d, w, true);
+      break;
+    }
+    case BVMul: {
+      mul_trits(arg(0), arg(1), d, w);
+      vector<Trit> acc;
+      for (size_t i = 2; i < n; ++i) {
+        acc.assign(d, d + w);
+        mul_trits(acc.data(), arg(i), d, w);
+      }
+      break;
+    }
+    case BVShl: shift_trits(arg(0), arg(1), d, w, true, false); break;
+    case BVLshr: shift_trits(arg(0), arg(1), d, w, false, false); break;
+    case BVAshr: shift_trits(arg(0), arg(1), d, w, false, true); break;
+    case BVUlt: d[0] = ult_trits(arg(0), arg(1), aw); break;
+    case BVUle: d[0] = t_not(ult_trits(arg(1), arg(0), aw)); break;
+    case BVUgt: d[0] = ult_trits(arg(1), arg(0), aw); break;
+    case BVUge: d[0] = t_not(ult_trits(arg(0), arg(1), aw)); break;
+    case BVSlt: d[0] = ult_trits(arg(0), arg(1), aw, true); break;
+    case BVSle: d[0] = t_not(ult_trits(arg(1), arg(0), aw, true)); break;
+    case BVSgt: d[0] = ult_trits(arg(1), arg(0), aw, true); break;
+    case BVSge: d[0] = t_not(ult_trits(arg(0), arg(1), aw, true)); break;
+    case Concat: {
+      // the first argument is the most significant
+      size_t j = w;
+      for (size_t i = 0; i < n; ++i) {
+        j -= arg_width(i);
+        std::copy(arg(i), arg(i) + arg_width(i), d + j);
+      }
+      assert(j == 0);
+      break;
+    }
+    case Extract:
+      std::copy(arg(0) + node.op.idx1, arg(0) + node.op.idx0 + 1, d);
+      break;
+    case Zero_Extend:
+    case Sign_Extend: {
+      Trit fill = (node.op.prim_op == Sign_Extend) ? arg(0)[aw - 1] : T0;
+      std::copy(arg(0), arg(0) + aw, d);
+      std::fill(d + aw, d + w, fill);
+      break;
+    }
+    case Repeat:
+      for (size_t j = 0; j < w; ++j) {
+        d[j] = arg(0)[j % aw];
+      }
+      break;
+    case Rotate_Left:
+      for (size_t j = 0; j < w; ++j) {
+        d[(j + node.op.idx0) % w] = arg(0)[j];
+      }
+      break;
+    case Rotate_Right:
+      for (size_t j = 0; j < w; ++j) {
+        d[j] = arg(0)[(j + node.op.idx0) % w];
+      }
+      break;
+    default:
+      // compile only creates nodes for supported operators
+      assert(false);
+      std::fill(d, d + w, TX);
+  }
+}
+
+}  // namespace pono
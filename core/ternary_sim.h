@@ -0,0 +1,130 @@
+/*********************                                                        */
+/*! \file ternary_sim.h
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Ternary (0/1/X) simulator for functional transition systems.
+**
+**        Evaluates terms bit by bit where a bit is 0, 1 or unknown (X).
+**        X propagates conservatively: a bit is only 0 or 1 if it has that
+**        value for every completion of the unknown inputs. Terms of
+**        unsupported sorts or operators evaluate to X.
+**        This is used to lift a concrete predecessor to a cube without
+**        calling a solver: a variable can be dropped from the cube if
+**        the target still evaluates to 1 when it is X.
+**
+**/
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "core/ts.h"
+
+namespace pono {
+
+class TernarySimulator
+{
+ public:
+  /** the value of a single bit */
+  enum Trit : uint8_t
+  {
+    ZERO = 0,
+    ONE = 1,
+    X = 2
+  };
+
+  /** @param ts the functional transition system
+   *  every state variable and input starts out as X
+   */
+  TernarySimulator(const TransitionSystem & ts);
+
+  /** Sets a state variable or input to a concrete value
+   *  @param v the variable
+   *  @param val a value of the same sort (booleans and bit-vectors only,
+   *         other variables stay X)
+   */
+  void assign(const smt::Term & v, const smt::Term & val);
+
+  /** Sets every bit of a state variable or input to X */
+  void unassign(const smt::Term & v);
+
+  /** Evaluate a boolean term under the current assignment
+   *  @param t the term, over current state variables and inputs
+   *  @param next if true, state variables in t are replaced by their
+   *         state update (i.e. t is evaluated in the next state)
+   *         and inputs are X
+   *  @return the value of t
+   */
+  Trit eval(const smt::Term & t, bool next = false);
+
+  /** Evaluate a boolean or bit-vector term under the current assignment
+   *  @param t the term
+   *  @param next see eval
+   *  @return the bits of t, least significant first
+   *          (empty for unsupported sorts)
+   */
+  std::vector<Trit> eval_bits(const smt::Term & t, bool next = false);
+
+  /** Lifting: drops variables from the current assignment in order
+   *  as long as target still evaluates to 1
+   *  The dropped variables are left X.
+   *  @param vars the assigned variables to try dropping
+   *  @param target a boolean term
+   *  @param next evaluate target in the next state (see eval)
+   *  @param needed set to the variables of vars that could not be dropped
+   *  @return false iff target is not 1 under the current assignment
+   *          (then nothing is dropped)
+   */
+  bool lift(const smt::TermVec & vars,
+            const smt::Term & target,
+            bool next,
+            smt::TermVec & needed);
+
+ protected:
+  /** A compiled term, its bits are mem_[offset ... offset + width) */
+  struct Node
+  {
+    smt::Op op;
+    size_t offset;
+    size_t width;  ///< 0 for unsupported sorts
+    std::vector<size_t> args;
+    bool leaf;  ///< variables, values and unsupported terms
+  };
+
+  /** Compile t and its subterms (if not yet compiled)
+   *  @return the index of t's node in nodes_
+   */
+  size_t compile(const smt::Term & t, bool next);
+
+  /** @return a new leaf node of width w with every bit X */
+  size_t make_leaf(size_t w);
+
+  /** Evaluates node n and its arguments, unless evaluated since the
+   *  assignment last changed
+   */
+  void eval_node(size_t n);
+
+  /** Computes the bits of a non-leaf node from its arguments */
+  void exec(const Node & node);
+
+  const TransitionSystem & ts_;
+
+  std::vector<Node> nodes_;
+  std::vector<Trit> mem_;
+  /** nodes of terms over the current (0) and next (1) state */
+  std::unordered_map<smt::Term, size_t> node_of_[2];
+
+  /** evaluation stamp of each node, current iff equal to epoch_ */
+  std::vector<size_t> stamp_;
+  size_t epoch_;
+};
+
+}  // namespace pono
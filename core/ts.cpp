@@ -626,6 +626,88 @@ void TransitionSystem::drop_state_updates(const TermVec & svs)
   }
 }
 
+void TransitionSystem::merge_statevars(const UnorderedTermMap & merged)
+{
+  if (!functional_) {
+    throw PonoException(
+        "Merging state variables requires a functional transition system");
+  }
+
+  UnorderedTermMap to_replace;
+  for (auto elem : merged) {
+    const Term & v = elem.first;
+    const Term & rep = elem.second;
+    if (!is_curr_var(v)) {
+      throw PonoException("Got non-state var in merge_statevars");
+    }
+    if (!rep->is_value()
+        && (!is_curr_var(rep) || merged.find(rep) != merged.end())) {
+      throw PonoException(
+          "Representatives in merge_statevars must be values or "
+          "state variables that are not merged");
+    }
+    to_replace[v] = rep;
+    to_replace[next_map_.at(v)] = rep->is_value() ? rep : next_map_.at(rep);
+  }
+
+  SubstitutionWalker sw(solver_, to_replace);
+
+  init_ = sw.visit(init_);
+
+  UnorderedTermMap new_state_updates;
+  for (auto elem : state_updates_) {
+    if (merged.find(elem.first) == merged.end()) {
+      new_state_updates[elem.first] = sw.visit(elem.second);
+    }
+  }
+  state_updates_ = new_state_updates;
+
+  for (auto & c : constraints_) {
+    c = sw.visit(c);
+  }
+
+  // the names of merged variables now refer to their representatives
+  // terms that had a representative name keep it, e.g. x stays "x"
+  // even if a merged y is now named x as well
+  unordered_map<string, Term> new_named_terms;
+  unordered_map<Term, string> new_term_to_name;
+  for (auto elem : named_terms_) {
+    Term t = sw.visit(elem.second);
+    new_named_terms[elem.first] = t;
+    auto it = term_to_name_.find(t);
+    if (it != term_to_name_.end()) {
+      new_term_to_name[t] = it->second;
+    } else if (new_term_to_name.find(t) == new_term_to_name.end()) {
+      new_term_to_name[t] = term_to_name_.at(elem.second);
+    }
+  }
+  named_terms_ = new_named_terms;
+  term_to_name_ = new_term_to_name;
+
+  for (auto elem : merged) {
+    const Term & v = elem.first;
+    Term nv = next_map_.at(v);
+    statevars_.erase(v);
+    next_statevars_.erase(nv);
+    next_map_.erase(v);
+    curr_map_.erase(nv);
+  }
+
+  // now rebuild trans
+  trans_ = solver_->make_term(true);
+  for (auto elem : state_updates_) {
+    Term eq = solver_->make_term(Equal, next_map_.at(elem.first), elem.second);
+    trans_ = solver_->make_term(And, trans_, eq);
+  }
+  for (auto constr : constraints_) {
+    trans_ = solver_->make_term(And, trans_, constr);
+  }
+
+  if (!constraints_.size()) {
+    deterministic_ = (state_updates_.size() == statevars_.size());
+  }
+}
+
 void TransitionSystem::replace_terms(const UnorderedTermMap & to_replace)
 {
   // first check that all the replacements contain known symbols
@@ -286,6 +286,16 @@ class TransitionSystem
    */
   void drop_state_updates(const smt::TermVec & svs);
 
+  /** EXPERTS ONLY
+   *  Replace state variables by a representative and remove them
+   *  from the system. Only substitutes in init, the state updates,
+   *  the constraints and the named terms, then rebuilds trans.
+   *  Only for functional systems
+   *  @param merged map from state variables to their representative
+   *         (a state variable that is not merged, or a value)
+   */
+  void merge_statevars(const smt::UnorderedTermMap & merged);
+
   /** EXPERTS ONLY
    * Replace terms in the transition system with other terms
    *  Traverses all the data structures and updates them with
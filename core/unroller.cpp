@@ -27,7 +27,7 @@ using namespace std;
 namespace pono {
 
 Unroller::Unroller(const TransitionSystem & ts, const SmtSolver & solver)
-    : ts_(ts), solver_(solver)
+    : ts_(ts), solver_(solver), num_cache_hits_(0), num_cache_misses_(0)
 {
 }
 
@@ -43,7 +43,79 @@ Term Unroller::at_time(const Term & t, unsigned int k)
     return it->second;
   }
 
-  return solver_->substitute(t, cache);
+  while (subterm_cache_.size() <= k) {
+    subterm_cache_.push_back(UnorderedTermMap());
+  }
+  UnorderedTermMap & subterms = subterm_cache_[k];
+
+  it = subterms.find(t);
+  if (it != subterms.end()) {
+    num_cache_hits_++;
+    return it->second;
+  }
+
+  // post-order traversal that only rebuilds subterms
+  // not unrolled at time k yet
+  TermVec to_visit({ t });
+  UnorderedTermSet visited;
+  Term n;
+  TermVec children;
+  while (to_visit.size()) {
+    n = to_visit.back();
+
+    if (cache.find(n) != cache.end()) {
+      to_visit.pop_back();
+      continue;
+    }
+
+    if (subterms.find(n) != subterms.end()) {
+      if (visited.find(n) == visited.end()) {
+        // unrolled by a previous call
+        num_cache_hits_++;
+      }
+      to_visit.pop_back();
+      continue;
+    }
+
+    Op op = n->get_op();
+    if (n->is_symbolic_const() || n->is_value() || op.is_null()) {
+      // leaf that doesn't change over time
+      to_visit.pop_back();
+      continue;
+    }
+
+    if (visited.find(n) == visited.end()) {
+      visited.insert(n);
+      for (const auto & c : n) {
+        to_visit.push_back(c);
+      }
+      continue;
+    }
+
+    to_visit.pop_back();
+    children.clear();
+    bool changed = false;
+    for (const auto & c : n) {
+      Term timed_c = c;
+      auto cit = cache.find(c);
+      if (cit != cache.end()) {
+        timed_c = cit->second;
+      } else {
+        cit = subterms.find(c);
+        if (cit != subterms.end()) {
+          timed_c = cit->second;
+        }
+      }
+      children.push_back(timed_c);
+      changed |= (timed_c != c);
+    }
+    subterms[n] = changed ? solver_->make_term(op, children) : n;
+    num_cache_misses_++;
+  }
+
+  auto sit = subterms.find(t);
+  // t is a leaf if it was not rebuilt
+  return (sit == subterms.end()) ? t : sit->second;
 }
 
 Term Unroller::untime(const Term & t) const
@@ -103,6 +175,8 @@ Term Unroller::var_at_time(const Term & v, unsigned int k)
   return timed_v;
 }
 
+void Unroller::clear_subterm_cache() { subterm_cache_.clear(); }
+
 UnorderedTermMap & Unroller::var_cache_at_time(unsigned int k)
 {
   while (time_cache_.size() <= k) {
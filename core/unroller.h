@@ -72,19 +72,34 @@ class Unroller
    */
   size_t get_curr_time(const smt::Term & t) const;
 
+  /** @return the number of (sub)terms at_time found already unrolled */
+  size_t num_cache_hits() const { return num_cache_hits_; }
+
+  /** @return the number of (sub)terms at_time had to rebuild */
+  size_t num_cache_misses() const { return num_cache_misses_; }
+
  protected:
   smt::Term var_at_time(const smt::Term & v, unsigned int k);
   virtual smt::UnorderedTermMap & var_cache_at_time(unsigned int k);
 
+  /** Forgets all unrolled non-variable subterms
+   *  needed if the variable substitution of a time changes
+   */
+  void clear_subterm_cache();
+
   const TransitionSystem & ts_;
   const smt::SmtSolver solver_;
 
   typedef std::vector<smt::UnorderedTermMap> TimeCache;
   TimeCache time_cache_;
   TimeCache time_var_map_;
+  TimeCache subterm_cache_;  ///< unrolled internal subterms per time
   smt::UnorderedTermMap untime_cache_;
   std::unordered_map<smt::Term, size_t> var_times_;
 
+  size_t num_cache_hits_;
+  size_t num_cache_misses_;
+
 };  // class Unroller
 
 }  // namespace pono
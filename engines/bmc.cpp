@@ -15,6 +15,12 @@
  **/
 
 #include "bmc.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+#include "utils/exceptions.h"
 #include "utils/logger.h"
 
 using namespace smt;
@@ -23,7 +29,7 @@ namespace pono {
 
 Bmc::Bmc(const Property & p, const TransitionSystem & ts,
          const SmtSolver & solver, PonoOptions opt)
-  : super(p, ts, solver, opt)
+  : super(p, ts, solver, opt), num_trans_(0)
 {
   engine_ = Engine::BMC;
 }
@@ -50,39 +56,128 @@ ProverResult Bmc::check_until(int k)
 {
   initialize();
 
-  for (int i = 0; i <= k; ++i) {
-    if (!step(i)) {
+  // number of bounds checked per solver call
+  int window = options_.bmc_step_;
+  assert(window > 0);
+
+  int i = 0;
+  if (options_.bmc_exponential_) {
+    // windows [0, 0], [1, 1], [2, 3], [4, 7], ...
+    if (!step(0)) {
+      compute_witness();
+      return ProverResult::FALSE;
+    }
+    i = 1;
+    window = 1;
+  }
+
+  // 64 bit arithmetic, k can be close to INT_MAX
+  while (i <= k) {
+    int hi = std::min<int64_t>(k, int64_t(i) + window - 1);
+    if (!step_window(i, hi)) {
       compute_witness();
       return ProverResult::FALSE;
     }
+    if (hi == k) {
+      break;
+    }
+    i = hi + 1;
+    if (options_.bmc_exponential_) {
+      window = std::min<int64_t>(2 * int64_t(window), k);
+    }
   }
   return ProverResult::UNKNOWN;
 }
 
-bool Bmc::step(int i)
+bool Bmc::step(int i) { return step_window(i, i); }
+
+bool Bmc::step_window(int lo, int hi)
 {
-  if (i <= reached_k_) {
+  if (hi <= reached_k_) {
     return true;
   }
+  lo = std::max(lo, reached_k_ + 1);
+
+  unroll_to(lo);
+  if (lo == hi) {
+    logger.log(1, "Checking bmc at bound: {}", lo);
+  } else {
+    logger.log(1, "Checking bmc at bounds: {} to {}", lo, hi);
+  }
 
-  bool res = true;
-  if (i > 0) {
-    solver_->assert_formula(unroller_.at_time(ts_.trans(), i - 1));
+  if (!check_bad(bad_in_window(lo, hi), lo == hi)) {
+    reached_k_ = hi;
+    return true;
   }
 
-  solver_->push();
-  logger.log(1, "Checking bmc at bound: {}", i);
-  solver_->assert_formula(unroller_.at_time(bad_, i));
-  Result r = solver_->check_sat();
-  if (r.is_sat()) {
-    res = false;
-  } else {
-    solver_->pop();
+  // bisect to find the shortest counterexample in the window
+  while (lo < hi) {
+    int mid = lo + (hi - lo) / 2;
+    logger.log(2, "Bisecting bmc at bounds: {} to {}", lo, mid);
+    if (check_bad(bad_in_window(lo, mid), false)) {
+      hi = mid;
+    } else {
+      // no counterexample up to mid, keep the prefix
+      reached_k_ = mid;
+      lo = mid + 1;
+      unroll_to(lo);
+    }
+  }
+
+  // get a model for the shortest counterexample
+  logger.log(1, "Found counterexample at bound: {}", lo);
+  if (lo != hi || !check_bad(unroller_.at_time(bad_, lo), true)) {
+    throw PonoException("Bmc: expected counterexample at bound "
+                        + std::to_string(lo));
   }
+  reached_k_ = lo;
+  return false;
+}
 
-  ++reached_k_;
+void Bmc::unroll_to(int n)
+{
+  while (num_trans_ < n) {
+    solver_->assert_formula(unroller_.at_time(ts_.trans(), num_trans_));
+    ++num_trans_;
+  }
+}
 
+Term Bmc::bad_in_window(int lo, int hi)
+{
+  assert(num_trans_ >= lo);
+  assert(lo <= hi);
+  Term res = unroller_.at_time(bad_, lo);
+  Term path = solver_->make_term(true);
+  for (int t = lo + 1; t <= hi; ++t) {
+    path = solver_->make_term(
+        And, path, unroller_.at_time(ts_.trans(), t - 1));
+    res = solver_->make_term(
+        Or, res, solver_->make_term(And, path, unroller_.at_time(bad_, t)));
+  }
   return res;
 }
 
+bool Bmc::check_bad(const Term & b, bool keep_model)
+{
+  Result r;
+  if (options_.activation_lits_) {
+    // the solver context is never popped
+    Term act = make_activation_lit("bmc_bad");
+    solver_->assert_formula(solver_->make_term(Implies, act, b));
+    r = solver_->check_sat_assuming({ act });
+    if (!r.is_sat() || !keep_model) {
+      // retire the literal
+      solver_->assert_formula(solver_->make_term(Not, act));
+    }
+  } else {
+    solver_->push();
+    solver_->assert_formula(b);
+    r = solver_->check_sat();
+    if (!r.is_sat() || !keep_model) {
+      solver_->pop();
+    }
+  }
+  return r.is_sat();
+}
+
 }  // namespace pono
@@ -38,6 +38,41 @@ public:
  protected:
   bool step(int i);
 
+  /** Checks all bounds in [lo, hi] with a single query
+   *  If that query is satisfiable, bisects inside the window
+   *  to find the shortest counterexample
+   *  @param lo the first bound of the window
+   *  @param hi the last bound of the window
+   *  @return true iff there is no counterexample of length lo..hi
+   *          if false, the solver holds a model of the shortest
+   *          counterexample and reached_k_ is its length
+   */
+  bool step_window(int lo, int hi);
+
+  /** Asserts the unrolled trans for times 0 through n-1
+   *  (if not already asserted)
+   */
+  void unroll_to(int n);
+
+  /** Creates a term that is satisfiable iff bad is reachable
+   *  at some bound in [lo, hi]
+   *  @requires trans is asserted for times 0 through lo-1
+   *  Each bound only requires trans up to that bound, so this
+   *  doesn't miss counterexamples that can't be extended
+   *  (e.g. because of constraints)
+   */
+  smt::Term bad_in_window(int lo, int hi);
+
+  /** Checks whether b is satisfiable with the current assertions
+   *  @param b the term to check
+   *  @param keep_model if true and b is satisfiable, the solver state
+   *         is not restored so that the model can be queried
+   *  @return true iff b is satisfiable
+   */
+  bool check_bad(const smt::Term & b, bool keep_model);
+
+  int num_trans_;  ///< number of unrolled trans asserted
+
 };  // class Bmc
 
 }  // namespace pono
@@ -56,16 +56,32 @@ bool BmcSimplePath::cover_step(int i)
     return false;
   }
 
-  solver_->push();
-  solver_->assert_formula(init0_);
   Term not_init = solver_->make_term(PrimOp::Not, ts_.init());
-  for (int j = 1; j <= i; ++j) {
-    solver_->assert_formula(unroller_.at_time(not_init, j));
-  }
-  if (ts_.statevars().size() && check_simple_path_lazy(i)) {
-    return true;
+  if (options_.activation_lits_) {
+    Term not_inits = solver_->make_term(true);
+    for (int j = 1; j <= i; ++j) {
+      not_inits = solver_->make_term(
+          PrimOp::And, not_inits, unroller_.at_time(not_init, j));
+    }
+    Term act = make_activation_lit("bmc_sp_cover");
+    solver_->assert_formula(
+        solver_->make_term(PrimOp::Implies, act, not_inits));
+    if (ts_.statevars().size()
+        && check_simple_path_lazy(i, { init_lit_, act })) {
+      return true;
+    }
+    solver_->assert_formula(solver_->make_term(PrimOp::Not, act));
+  } else {
+    solver_->push();
+    solver_->assert_formula(init0_);
+    for (int j = 1; j <= i; ++j) {
+      solver_->assert_formula(unroller_.at_time(not_init, j));
+    }
+    if (ts_.statevars().size() && check_simple_path_lazy(i)) {
+      return true;
+    }
+    solver_->pop();
   }
-  solver_->pop();
 
   ++reached_k_;
 
@@ -18,6 +18,7 @@
 #include <random>
 
 #include "assert.h"
+#include "utils/logger.h"
 #include "utils/term_analysis.h"
 
 using namespace smt;
@@ -98,8 +99,17 @@ std::vector<IC3Formula> IC3::inductive_generalization(size_t i,
 {
   assert(!c.is_disjunction());  // expecting a cube
 
-  if (options_.mbic3_indgen_mode != 0) {
-    throw PonoException("Boolean IC3 only supports indgen mode 0 but got "
+  if (options_.mbic3_indgen_mode == 1 || options_.mbic3_indgen_mode == 2) {
+    TermVec lits = c.children;
+    if (options_.random_seed_ > 0) {
+      shuffle(lits.begin(),
+              lits.end(),
+              default_random_engine(options_.random_seed_));
+    }
+    mic(i, lits, 1);
+    return { ic3formula_negate(ic3formula_conjunction(lits)) };
+  } else if (options_.mbic3_indgen_mode != 0) {
+    throw PonoException("Boolean IC3 only supports indgen modes 0-2 but got "
                         + std::to_string(options_.mbic3_indgen_mode));
   }
 
@@ -152,6 +162,7 @@ std::vector<IC3Formula> IC3::inductive_generalization(size_t i,
         if (r.is_sat()) {
           // we cannot drop a
           pop_solver_context();
+          release_labels(tmp);
         } else {
           new_tmp.clear();
           removed.clear();
@@ -167,6 +178,7 @@ std::vector<IC3Formula> IC3::inductive_generalization(size_t i,
           }
 
           pop_solver_context();
+          release_labels(tmp);
 
           // keep in mind that you cannot drop a literal if it causes c to
           // intersect with the initial states
@@ -202,7 +214,13 @@ IC3Formula IC3::generalize_predecessor(size_t i, const IC3Formula & c)
   const UnorderedTermSet & statevars = ts_.statevars();
   TermVec input_lits, next_lits;
   const IC3Formula & icf = get_model_ic3formula(&input_lits, &next_lits);
-  const TermVec & cube_lits = icf.children;
+  TermVec cube_lits = icf.children;
+  if (pregen_round_) {
+    // another predecessor from the same model, try another literal order
+    shuffle(cube_lits.begin(),
+            cube_lits.end(),
+            default_random_engine(options_.random_seed_ + pregen_round_));
+  }
 
   if (i == 1) {
     // don't need to generalize if i == 1
@@ -210,6 +228,25 @@ IC3Formula IC3::generalize_predecessor(size_t i, const IC3Formula & c)
     return get_model_ic3formula();
   }
 
+  if (options_.ic3_ternary_sim_) {
+    // literals are state variables or their negation
+    TermVec vars, needed;
+    vars.reserve(cube_lits.size());
+    for (const auto & l : cube_lits) {
+      vars.push_back(l->get_op() == Not ? *l->begin() : l);
+    }
+    if (ternary_lift(c, vars, needed)) {
+      UnorderedTermSet keep(needed.begin(), needed.end());
+      TermVec red_cube_lits;
+      for (size_t j = 0; j < vars.size(); ++j) {
+        if (keep.find(vars[j]) != keep.end()) {
+          red_cube_lits.push_back(cube_lits[j]);
+        }
+      }
+      return ic3formula_conjunction(red_cube_lits);
+    }
+  }
+
   Term formula = make_and(input_lits);
   if (ts_.is_deterministic()) {
     // NOTE: need to use full trans, not just trans_label_ here
@@ -253,6 +290,132 @@ IC3Formula IC3::generalize_predecessor(size_t i, const IC3Formula & c)
   return res;
 }
 
+void IC3::mic(size_t i, TermVec & lits, size_t depth)
+{
+  const TermVec candidates = lits;
+  TermVec tmp;
+  for (const auto & a : candidates) {
+    if (lits.size() <= 1) {
+      break;
+    }
+    if (std::find(lits.begin(), lits.end(), a) == lits.end()) {
+      // already dropped with an unsat core
+      continue;
+    }
+
+    tmp.clear();
+    for (const auto & aa : lits) {
+      if (a != aa) {
+        tmp.push_back(aa);
+      }
+    }
+    if (down(i, tmp, depth)) {
+      lits = tmp;
+    }
+  }
+}
+
+bool IC3::down(size_t i, TermVec & lits, size_t depth)
+{
+  bool use_ctgs = options_.mbic3_indgen_mode == 2
+                  && depth <= options_.ic3_ctg_max_depth_;
+  size_t num_ctgs = 0;
+  TermVec pred, ctg, tmp;
+  UnorderedTermSet pred_lits;
+  while (true) {
+    if (lits.empty() || check_intersects_initial(make_and(lits))) {
+      return false;
+    }
+
+    pred.clear();
+    if (rel_ind_cube(i, lits, &pred)) {
+      return true;
+    }
+
+    if (use_ctgs && num_ctgs < options_.ic3_ctg_max_ctgs_ && i > 1
+        && !check_intersects_initial(make_and(pred))) {
+      ctg = pred;
+      if (rel_ind_cube(i - 1, ctg, nullptr)) {
+        // block the CTG at the highest frame possible
+        num_ctgs++;
+        size_t j = i - 1;
+        while (j + 1 < frames_.size()) {
+          tmp = ctg;
+          if (!rel_ind_cube(j + 1, tmp, nullptr)) {
+            break;
+          }
+          ctg = tmp;
+          ++j;
+        }
+        mic(j, ctg, depth + 1);
+        logger.log(3, "Blocking CTG at frame {}", j);
+        constrain_frame(j, ic3formula_negate(ic3formula_conjunction(ctg)));
+        continue;
+      }
+    }
+
+    // join with the predecessor: keep the literals that hold in it
+    // at least one literal of lits is false in the predecessor
+    num_ctgs = 0;
+    pred_lits.clear();
+    pred_lits.insert(pred.begin(), pred.end());
+    tmp.clear();
+    for (const auto & a : lits) {
+      if (pred_lits.find(a) != pred_lits.end()) {
+        tmp.push_back(a);
+      }
+    }
+    assert(tmp.size() < lits.size());
+    lits = tmp;
+  }
+}
+
+bool IC3::rel_ind_cube(size_t i, TermVec & lits, TermVec * pred)
+{
+  assert(i > 0);
+  assert(solver_context_ == 0);
+  push_solver_context();
+  assert_frame_labels(i - 1);
+  assert_trans_label();
+  solver_->assert_formula(solver_->make_term(Not, make_and(lits)));
+
+  TermVec bool_assump;
+  for (const auto & t : lits) {
+    Term l = label(t);
+    solver_->assert_formula(solver_->make_term(Implies, l, ts_.next(t)));
+    bool_assump.push_back(l);
+  }
+
+  Result r = check_sat_assuming(bool_assump);
+  assert(!r.is_unknown());
+  if (r.is_sat()) {
+    if (pred) {
+      *pred = get_model_ic3formula().children;
+    }
+    pop_solver_context();
+    release_labels(lits);
+    return false;
+  }
+
+  UnorderedTermSet core_set;
+  solver_->get_unsat_core(core_set);
+  TermVec kept, removed;
+  for (size_t j = 0; j < bool_assump.size(); ++j) {
+    if (core_set.find(bool_assump[j]) != core_set.end()) {
+      kept.push_back(lits[j]);
+    } else {
+      removed.push_back(lits[j]);
+    }
+  }
+  pop_solver_context();
+  release_labels(lits);
+
+  // can't drop literals that make the cube intersect the initial states
+  fix_if_intersects_initial(kept, removed);
+  lits = kept;
+  return true;
+}
+
 void IC3::check_ts() const
 {
   const Sort &boolsort = solver_->make_sort(BOOL);
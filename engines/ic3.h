@@ -44,6 +44,38 @@ class IC3 : public IC3Base
 
   void check_ts() const override;
 
+  // inductive generalization with down and CTGs (indgen modes 1 and 2)
+  // see Hassan, Bradley, Somenzi: Better Generalization in IC3
+
+  /** Drops literals from a cube that is inductive relative to F[i-1]
+   *  while keeping it inductive relative to F[i-1], using down
+   *  @param i the frame number
+   *  @param lits the literals of the cube, updated in place
+   *  @param depth the CTG recursion depth (starts at 1)
+   */
+  void mic(size_t i, smt::TermVec & lits, size_t depth);
+
+  /** Looks for a subcube of lits that is inductive relative to F[i-1]
+   *  by intersecting it with the predecessors that violate consecution
+   *  In indgen mode 2, predecessors (CTGs) that are themselves inductive
+   *  relative to F[i-2] are blocked instead, up to the configured limits
+   *  @param i the frame number
+   *  @param lits the literals of the cube, set to the subcube on success
+   *  @param depth the CTG recursion depth
+   *  @return true iff an inductive subcube disjoint from init was found
+   */
+  bool down(size_t i, smt::TermVec & lits, size_t depth);
+
+  /** Relative inductiveness check of a cube using the frame and trans
+   *  labels: F[i-1] /\ !c /\ T /\ c'
+   *  @param i the frame number
+   *  @param lits the literals of the cube c, if unsat reduced with an unsat
+   *         core (but still disjoint from init)
+   *  @param pred if non-null and the query is sat, set to the literals of
+   *         the predecessor state
+   *  @return true iff the query is unsat
+   */
+  bool rel_ind_cube(size_t i, smt::TermVec & lits, smt::TermVec * pred);
 };
 
 }  // namespace pono
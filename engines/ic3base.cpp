@@ -17,11 +17,18 @@
 
 #include "engines/ic3base.h"
 
+#include <unistd.h>
+
 #include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <thread>
 
 #include "assert.h"
 #include "smt/available_solvers.h"
 #include "utils/logger.h"
+#include "utils/term_io.h"
 
 using namespace smt;
 using namespace std;
@@ -30,6 +37,50 @@ namespace pono {
 
 // helper functions
 
+/** @return the resident memory of this process in MB
+ *          0 if it is unknown (e.g. /proc is not available)
+ */
+static size_t resident_memory_mb()
+{
+  std::ifstream statm("/proc/self/statm");
+  size_t total_pages, resident_pages;
+  if (!(statm >> total_pages >> resident_pages)) {
+    return 0;
+  }
+  return resident_pages * sysconf(_SC_PAGESIZE) / (1024 * 1024);
+}
+
+/** set by handle_sigterm, checked at safe points (see checkpoint_on_sigterm)
+ */
+static volatile sig_atomic_t sigterm_received = 0;
+
+static void handle_sigterm(int) { sigterm_received = 1; }
+
+/** Installs handle_sigterm while it is in scope (if enabled)
+ *  so that IC3 can save a checkpoint before terminating
+ */
+class SigtermGuard
+{
+ public:
+  SigtermGuard(bool enable) : enabled_(enable), prev_(SIG_DFL)
+  {
+    if (enabled_) {
+      prev_ = std::signal(SIGTERM, handle_sigterm);
+    }
+  }
+
+  ~SigtermGuard()
+  {
+    if (enabled_) {
+      std::signal(SIGTERM, prev_);
+    }
+  }
+
+ private:
+  bool enabled_;
+  void (*prev_)(int);
+};
+
 /** Less than comparison of the hash of two terms
  *  for use in sorting
  *  @param t0 the first term
@@ -58,6 +109,143 @@ static bool subsumes(const IC3Formula &a, const IC3Formula &b)
          && std::includes(bc.begin(), bc.end(), ac.begin(), ac.end());
 }
 
+/** @return a 64-bit signature with one (hashed) bit per literal
+ *  if a subsumes b, then the signature of a is included in that of b
+ */
+static uint64_t signature(const IC3Formula & u)
+{
+  uint64_t sig = 0;
+  for (const auto & c : u.children) {
+    sig |= 1ull << ((c->hash() * 0x9e3779b97f4a7c15ull) >> 58);
+  }
+  return sig;
+}
+
+/** FrameDB */
+
+void FrameDB::clear()
+{
+  entries_.clear();
+  frames_.clear();
+  occurs_.clear();
+  first_occurs_.clear();
+  num_dead_ = 0;
+}
+
+void FrameDB::push_frame()
+{
+  if (num_dead_ > entries_.size() / 2) {
+    compact();
+  }
+  frames_.push_back({});
+}
+
+size_t FrameDB::add(size_t i, const IC3Formula & u)
+{
+  assert(u.is_disjunction());
+  assert(u.children.size());
+  size_t id = entries_.size();
+  std::vector<size_t> & Fi = frames_.at(i);
+  entries_.push_back({ u, signature(u), i, Fi.size(), true });
+  Fi.push_back(id);
+  index(id);
+  return id;
+}
+
+void FrameDB::remove(size_t id)
+{
+  Entry & e = entries_.at(id);
+  assert(e.alive);
+  e.alive = false;
+  num_dead_++;
+
+  // swap with the last lemma of the frame
+  std::vector<size_t> & F = frames_.at(e.frame);
+  size_t last = F.back();
+  F[e.pos] = last;
+  entries_[last].pos = e.pos;
+  F.pop_back();
+}
+
+size_t FrameDB::remove_subsumed(size_t i, const IC3Formula & u)
+{
+  // every lemma subsumed by u contains all of its literals
+  // so it's enough to look at the shortest occurrence list
+  const std::vector<size_t> * shortest = nullptr;
+  for (const auto & c : u.children) {
+    auto it = occurs_.find(c);
+    if (it == occurs_.end()) {
+      return 0;
+    } else if (!shortest || it->second.size() < shortest->size()) {
+      shortest = &it->second;
+    }
+  }
+  if (!shortest) {
+    return 0;
+  }
+
+  uint64_t sig = signature(u);
+  std::vector<size_t> to_remove;
+  for (const auto & id : *shortest) {
+    const Entry & e = entries_[id];
+    if (e.alive && e.frame >= 1 && e.frame <= i && (sig & ~e.sig) == 0
+        && subsumes(u, e.lemma)) {
+      to_remove.push_back(id);
+    }
+  }
+  for (const auto & id : to_remove) {
+    remove(id);
+  }
+  return to_remove.size();
+}
+
+bool FrameDB::subsumed(size_t i, const IC3Formula & u) const
+{
+  // a lemma that subsumes u contains its first literal
+  // which is a literal of u, so each candidate is visited once
+  uint64_t sig = signature(u);
+  for (const auto & c : u.children) {
+    auto it = first_occurs_.find(c);
+    if (it == first_occurs_.end()) {
+      continue;
+    }
+    for (const auto & id : it->second) {
+      const Entry & e = entries_[id];
+      if (e.alive && e.frame >= i && (e.sig & ~sig) == 0
+          && subsumes(e.lemma, u)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void FrameDB::compact()
+{
+  std::vector<Entry> old_entries;
+  old_entries.swap(entries_);
+  occurs_.clear();
+  first_occurs_.clear();
+  num_dead_ = 0;
+  for (auto & F : frames_) {
+    for (auto & id : F) {
+      size_t new_id = entries_.size();
+      entries_.push_back(old_entries[id]);
+      id = new_id;
+      index(new_id);
+    }
+  }
+}
+
+void FrameDB::index(size_t id)
+{
+  const TermVec & children = entries_[id].lemma.children;
+  for (const auto & c : children) {
+    occurs_[c].push_back(id);
+  }
+  first_occurs_[children[0]].push_back(id);
+}
+
 /** IC3Base */
 
 IC3Base::IC3Base(const Property & p, const TransitionSystem & ts,
@@ -66,18 +254,23 @@ IC3Base::IC3Base(const Property & p, const TransitionSystem & ts,
       reducer_(create_solver(s->get_solver_enum())),
       solver_context_(0),
       num_check_sat_since_reset_(0),
+      num_lemmas_since_reset_(0),
+      rss_at_reset_(0),
+      rss_checked_at_(0),
+      last_reset_time_(std::chrono::steady_clock::now()),
       failed_to_reset_solver_(false),
-      cex_pg_(nullptr)
+      cex_pg_(nullptr),
+      checkpoint_loaded_(false),
+      pregen_round_(0),
+      num_labels_since_gc_(0),
+      num_disabled_labels_(0),
+      num_labels_created_(0),
+      num_ternary_lifts_(0),
+      num_ternary_fallbacks_(0)
 {
 }
 
-IC3Base::~IC3Base()
-{
-  if (cex_pg_) {
-    delete cex_pg_;
-    cex_pg_ = nullptr;
-  }
-}
+IC3Base::~IC3Base() {}
 
 void IC3Base::initialize()
 {
@@ -100,6 +293,8 @@ void IC3Base::initialize()
   frames_.clear();
   frame_labels_.clear();
   proof_goals_.clear();
+  prop_workers_.clear();
+  frame_log_.clear();
   // first frame is always the initial states
   push_frame();
   // can't use constrain_frame for initial states because not guaranteed to be
@@ -128,18 +323,19 @@ ProverResult IC3Base::check_until(int k)
   // ever initializing base classes
   assert(initialized_);
 
+  SigtermGuard sigterm_guard(!options_.ic3_checkpoint_.empty());
+
   ProverResult res;
   RefineResult ref_res;
   int i = reached_k_ + 1;
   assert(i >= 0);
   while (i <= k) {
+    checkpoint_on_sigterm();
+
     // reset cex_pg_ to null
     // there might be multiple abstract traces if there's a derived class
     // doing abstraction refinement
-    if (cex_pg_) {
-      delete cex_pg_;
-      cex_pg_ = nullptr;
-    }
+    cex_pg_ = nullptr;
 
     res = step(i);
     ref_res = REFINE_NONE;  // just a default value
@@ -149,7 +345,7 @@ ProverResult IC3Base::check_until(int k)
     } else if (res == ProverResult::FALSE) {
       // expecting cex_pg_ to be non-null and point to the first proof goal in a
       // trace
-      assert(cex_pg_->target.term);
+      assert(cex_pg_->target->term);
       ref_res = refine();
       if (ref_res == RefineResult::REFINE_NONE) {
         // found a concrete counterexample
@@ -268,6 +464,11 @@ ProverResult IC3Base::step(int i)
   // at this point there are reached_k_ + 1 frames that don't
   // intersect bad, and reached_k_ + 2 frames overall
   assert(reached_k_ + 2 == frames_.size());
+
+  if (!checkpoint_loaded_ && !options_.ic3_checkpoint_.empty()) {
+    load_checkpoint();
+  }
+
   logger.log(1, "Blocking phase at frame {}", i);
   // blocking phase
   while (intersects_bad()) {
@@ -288,10 +489,14 @@ ProverResult IC3Base::step(int i)
       // which is the frame that just had all terms
       // from the previous frames propagated
       invar_ = get_frame_term(j + 1);
+      save_checkpoint();
       return ProverResult::TRUE;
     }
   }
 
+  import_lemmas();
+  save_checkpoint();
+
   ++reached_k_;
 
   return ProverResult::UNKNOWN;
@@ -308,7 +513,7 @@ ProverResult IC3Base::step_0()
   Result r = check_sat();
   if (r.is_sat()) {
     const IC3Formula &c = get_model_ic3formula();
-    cex_pg_ = new ProofGoal(c, 0, nullptr);
+    cex_pg_ = proof_goals_.make(c, 0, nullptr);
     pop_solver_context();
     return ProverResult::FALSE;
   } else {
@@ -344,14 +549,7 @@ bool IC3Base::rel_ind_check(size_t i,
 
   Result r = check_sat();
   if (r.is_sat()) {
-    IC3Formula predecessor;
-    if (options_.ic3_pregen_) {
-      predecessor = generalize_predecessor(i, c);
-    } else {
-      predecessor = get_model_ic3formula();
-    }
-    assert(ic3formula_check_valid(predecessor));
-    out.push_back(predecessor);
+    get_predecessors(i, c, out);
     pop_solver_context();
   } else {
     // TODO: consider automatically taking advantage
@@ -362,83 +560,135 @@ bool IC3Base::rel_ind_check(size_t i,
     //         or it's possible they all can function approximately the same
     //       would also have to move the pop_solver_context later
     pop_solver_context();
-    if (options_.ic3_indgen_) {
-      assert(solver_context_ == 0); // important that there are no lingering assertions
-      out = inductive_generalization(i, c);
-    } else {
-      out.push_back(ic3formula_negate(c));
-    }
-    Term conj = solver_->make_term(true);
-    for (const auto &u : out) {
-      conj = solver_->make_term(And, conj, u.term);
-      assert(ic3formula_check_valid(u));
-      assert(ts_.only_curr(u.term));
-    }
-    assert(!check_intersects_initial(solver_->make_term(Not, conj)));
+    out = blocking_units(i, c);
   }
   assert(solver_context_ == 0);
 
   if (r.is_sat()) {
-    // for now, assuming that there's only one predecessor produced
-    assert(out.size() == 1);
-    // this check needs to be here after the solver context has been popped
-    // if i == 1 and there's a predecessor, then it should be an initial state
-    assert(i != 1 || check_intersects_initial(out.at(0).term));
-
-    // should never intersect with a frame before F[i-1]
-    // otherwise, this predecessor should have been found
-    // in a previous step (before a new frame was pushed)
-    assert(i < 2 || !check_intersects(out.at(0).term, get_frame_term(i - 2)));
+    assert(out.size());
+    for (const auto & pred : out) {
+      // this check needs to be here after the solver context has been popped
+      // if i == 1 and there's a predecessor, then it should be an initial
+      // state
+      assert(i != 1 || check_intersects_initial(pred.term));
+
+      // should never intersect with a frame before F[i-1]
+      // otherwise, this predecessor should have been found
+      // in a previous step (before a new frame was pushed)
+      assert(i < 2 || !check_intersects(pred.term, get_frame_term(i - 2)));
+    }
   }
 
   assert(!r.is_unknown());
   return r.is_unsat();
 }
 
+void IC3Base::get_predecessors(size_t i,
+                               const IC3Formula & c,
+                               vector<IC3Formula> & out)
+{
+  if (!options_.ic3_pregen_) {
+    IC3Formula predecessor = get_model_ic3formula();
+    assert(ic3formula_check_valid(predecessor));
+    out.push_back(predecessor);
+    return;
+  }
+
+  // every generalization of the same model is a valid predecessor
+  // generalize_predecessor doesn't use solver_, so the model stays
+  UnorderedTermSet seen;
+  for (pregen_round_ = 0; pregen_round_ < options_.ic3_num_predecessors_;
+       ++pregen_round_) {
+    IC3Formula predecessor = generalize_predecessor(i, c);
+    assert(ic3formula_check_valid(predecessor));
+    if (seen.insert(predecessor.term).second) {
+      out.push_back(predecessor);
+    }
+  }
+  pregen_round_ = 0;
+}
+
+vector<IC3Formula> IC3Base::blocking_units(size_t i, const IC3Formula & c)
+{
+  vector<IC3Formula> out;
+  if (options_.ic3_indgen_) {
+    assert(solver_context_ == 0); // important that there are no lingering assertions
+    out = inductive_generalization(i, c);
+  } else {
+    out.push_back(ic3formula_negate(c));
+  }
+  Term conj = solver_->make_term(true);
+  for (const auto &u : out) {
+    conj = solver_->make_term(And, conj, u.term);
+    assert(ic3formula_check_valid(u));
+    assert(ts_.only_curr(u.term));
+  }
+  assert(!check_intersects_initial(solver_->make_term(Not, conj)));
+  return out;
+}
+
 // Helper methods
 
 bool IC3Base::block_all()
 {
   while (has_proof_goals()) {
-    if (options_.ic3_reset_interval_
-        && num_check_sat_since_reset_ >= options_.ic3_reset_interval_) {
+    checkpoint_on_sigterm();
+
+    if (should_reset_solver()) {
       reset_solver();
+    } else if (options_.ic3_label_gc_
+               && num_labels_since_gc_ >= options_.ic3_label_gc_) {
+      collect_labels(true);
     }
 
-    const ProofGoal * pg = get_top_proof_goal();
+    ProofGoal * pg = get_top_proof_goal();
     if (is_blocked(pg)) {
       logger.log(3,
                  "Skipping already blocked proof goal <{}, {}>",
-                 pg->target.term->to_string(),
+                 pg->target->term->to_string(),
                  pg->idx);
       remove_top_proof_goal();
       continue;
     };
 
+    if (options_.ic3_batch_goals_ > 1 && block_batch()) {
+      continue;
+    }
+
     // block can fail, which just means a
     // new proof goal will be added
-    if (block(pg)) {
-      // if successfully blocked, then remove that proof goal
-      // expecting the top proof goal to still be pg
-      assert(pg == get_top_proof_goal());
-      remove_top_proof_goal();
-    } else if (!pg->idx) {
+    // if it succeeds, block removes pg from the proof goals
+    if (!block(pg) && !pg->idx) {
       // if a proof goal cannot be blocked at zero
       // then there's a counterexample
-      // NOTE: creating a new allocation
-      //       because the pg memory is already managed
-      //       by proof_goals_
-      cex_pg_ = new ProofGoal(pg->target, pg->idx, pg->next);
+      // pg stays valid until the proof goals are cleared
+      cex_pg_ = pg;
       return false;
     }
   }
   assert(!has_proof_goals());
+
+  logger.log(2,
+             "Proof goals: {} created, {} rescheduled, {} resident",
+             proof_goals_.num_created(),
+             proof_goals_.num_reused(),
+             proof_goals_.num_resident());
+  if (ternary_sim_) {
+    logger.log(2,
+               "Ternary simulation: {} predecessors lifted without the "
+               "solver, {} fell back to the solver",
+               num_ternary_lifts_,
+               num_ternary_fallbacks_);
+  }
+  // nothing refers to the blocked proof goals anymore
+  // recycle their memory
+  proof_goals_.clear();
   return true;
 }
 
-bool IC3Base::block(const ProofGoal * pg)
+bool IC3Base::block(ProofGoal * pg)
 {
-  const IC3Formula & c = pg->target;
+  const IC3Formula & c = *pg->target;
   size_t i = pg->idx;
 
   logger.log(
@@ -456,53 +706,131 @@ bool IC3Base::block(const ProofGoal * pg)
   vector<IC3Formula> collateral;  // populated by rel_ind_check
   if (rel_ind_check(i, c, collateral)) {
     // collateral is a vector of blocking units
-    assert(collateral.size());
-    logger.log(3, "Blocking term at frame {}: {}", i, c.term->to_string());
-    if (options_.verbosity_ >= 3) {
-      for (const auto &u : collateral) {
-        logger.log(3, " with {}", u.term->to_string());
-      }
+    // expecting the top proof goal to still be pg
+    assert(pg == get_top_proof_goal());
+    remove_top_proof_goal();
+    add_blocking_units(pg, collateral);
+    return true;
+  } else {
+    // collateral is a vector of predecessors
+    // (more than one with options_.ic3_num_predecessors_)
+    for (const auto & pred : collateral) {
+      add_proof_goal(pred, i - 1, pg);
+    }
+    return false;
+  }
+}
+
+void IC3Base::add_blocking_units(ProofGoal * pg,
+                                 const vector<IC3Formula> & units)
+{
+  const IC3Formula & c = *pg->target;
+  size_t i = pg->idx;
+
+  assert(units.size());
+  logger.log(3, "Blocking term at frame {}: {}", i, c.term->to_string());
+  if (options_.verbosity_ >= 3) {
+    for (const auto &u : units) {
+      logger.log(3, " with {}", u.term->to_string());
+    }
+  }
+
+  // Most IC3 implementations will have only a single element in the vector
+  // e.g. a single clause. But this is not guaranteed for all
+  // for example, interpolant-based generalization for bit-vectors is not
+  // always a single clause
+  size_t min_idx = frames_.size();
+  for (const auto &bu : units) {
+    // try to push
+    size_t idx = find_highest_frame(i, bu);
+    constrain_frame(idx, bu);
+    if (idx < min_idx) {
+      min_idx = idx;
+    }
+  }
+
+  // we're limited by the minimum index that a conjunct could be pushed to
+  // try to block the same obligation there, as in PDR's rescheduling
+  if (min_idx + 1 < frames_.size()) {
+    proof_goals_.reschedule(pg, min_idx + 1);
+  }
+}
+
+bool IC3Base::block_batch()
+{
+  vector<ProofGoal *> batch =
+      proof_goals_.pop_batch(options_.ic3_batch_goals_);
+  if (batch.size() < 2 || !batch[0]->idx) {
+    for (auto pg : batch) {
+      proof_goals_.push(pg);
     }
+    return false;
+  }
+
+  size_t i = batch[0]->idx;
+  logger.log(
+      3, "Checking {} proof goals at frame {} together", batch.size(), i);
 
-    // Most IC3 implementations will have only a single element in the vector
-    // e.g. a single clause. But this is not guaranteed for all
-    // for example, interpolant-based generalization for bit-vectors is not
-    // always a single clause
-    size_t min_idx = frames_.size();
-    for (const auto &bu : collateral) {
-      // try to push
-      size_t idx = find_highest_frame(i, bu);
-      constrain_frame(idx, bu);
-      if (idx < min_idx) {
-        min_idx = idx;
+  assert(solver_context_ == 0);
+  push_solver_context();
+  assert_frame_labels(i - 1);
+  assert_trans_label();
+  TermVec goals, acts;
+  for (auto pg : batch) {
+    const Term & c = pg->target->term;
+    goals.push_back(c);
+    Term a = label(c);
+    solver_->assert_formula(solver_->make_term(
+        Implies,
+        a,
+        solver_->make_term(And, solver_->make_term(Not, c), ts_.next(c))));
+    acts.push_back(a);
+  }
+  Term some_goal = acts[0];
+  for (size_t j = 1; j < acts.size(); ++j) {
+    some_goal = solver_->make_term(Or, some_goal, acts[j]);
+  }
+  solver_->assert_formula(some_goal);
+
+  Result r = check_sat();
+  assert(!r.is_unknown());
+  if (r.is_sat()) {
+    // extend the first proof goal with a predecessor in this model
+    ProofGoal * pg = batch[0];
+    for (size_t j = 0; j < batch.size(); ++j) {
+      if (solver_->get_value(acts[j]) == solver_true_) {
+        pg = batch[j];
+        break;
       }
     }
+    vector<IC3Formula> preds;
+    get_predecessors(i, *pg->target, preds);
+    pop_solver_context();
+    release_labels(goals);
 
-    // we're limited by the minimum index that a conjunct could be pushed to
-    if (min_idx + 1 < frames_.size()) {
-      add_proof_goal(c, min_idx + 1, pg->next);
+    for (auto p : batch) {
+      proof_goals_.push(p);
+    }
+    for (const auto & pred : preds) {
+      add_proof_goal(pred, i - 1, pg);
     }
     return true;
-  } else {
-    // collateral is a vector of predecessors
-    // for now, assume there is only one
-    // TODO: extend this to support multiple predecessors
-    assert(collateral.size() == 1);
-    add_proof_goal(collateral.at(0), i - 1, pg);
-    return false;
   }
+
+  // every proof goal of the batch is inductive relative to F[i-1]
+  pop_solver_context();
+  release_labels(goals);
+  for (auto pg : batch) {
+    add_blocking_units(pg, blocking_units(i, *pg->target));
+  }
+  return true;
 }
 
 bool IC3Base::is_blocked(const ProofGoal * pg)
 {
   // syntactic check
-  for (size_t i = pg->idx; i < frames_.size(); ++i) {
-    const vector<IC3Formula> & Fi = frames_.at(i);
-    for (size_t j = 0; j < Fi.size(); ++j) {
-      if (subsumes(Fi[j], ic3formula_negate(pg->target))) {
-        return true;
-      }
-    }
+  if (frames_.subsumed(pg->idx, ic3formula_negate(*pg->target))) {
+    return true;
   }
 
   // now semantic check
@@ -510,7 +838,7 @@ bool IC3Base::is_blocked(const ProofGoal * pg)
 
   push_solver_context();
   assert_frame_labels(pg->idx);
-  solver_->assert_formula(pg->target.term);
+  solver_->assert_formula(pg->target->term);
   Result r = check_sat();
   pop_solver_context();
 
@@ -521,16 +849,19 @@ bool IC3Base::propagate(size_t i)
 {
   assert(i + 1 < frames_.size());
 
-  vector<IC3Formula> to_push;
-  vector<IC3Formula> & Fi = frames_.at(i);
+  if (options_.ic3_propagation_threads_ > 1) {
+    return propagate_parallel(i);
+  }
+
+  vector<size_t> to_push;
+  const vector<size_t> & Fi = frames_.frame(i);
 
   push_solver_context();
   assert_frame_labels(i);
   assert_trans_label();
 
-  size_t k = 0;
-  for (size_t j = 0; j < Fi.size(); ++j) {
-    const Term & t = Fi.at(j).term;
+  for (const auto & id : Fi) {
+    const Term & t = frames_.lemma(id).term;
 
     // Relative inductiveness check
     // Check F[i] /\ t /\ T /\ -t'
@@ -541,22 +872,175 @@ bool IC3Base::propagate(size_t i)
     Result r = check_sat();
     assert(!r.is_unknown());
     if (r.is_unsat()) {
-      to_push.push_back(Fi.at(j));
-    } else {
-      Fi[k++] = Fi.at(j);
+      to_push.push_back(id);
     }
 
     pop_solver_context();
   }
-  Fi.resize(k);
 
   pop_solver_context();
 
-  for (const auto &f : to_push) {
+  for (const auto & id : to_push) {
+    IC3Formula f = frames_.lemma(id);
+    frames_.remove(id);
     constrain_frame(i + 1, f, false);
   }
 
-  return Fi.empty();
+  return frames_.frame(i).empty();
+}
+
+bool IC3Base::propagate_parallel(size_t i)
+{
+  assert(i + 1 < frames_.size());
+  assert(solver_context_ == 0);
+
+  sync_propagation_workers();
+  size_t num_workers = prop_workers_.size();
+
+  // terms are translated here, each thread only uses its own solver
+  vector<size_t> ids = frames_.frame(i);
+  vector<Term> queries(ids.size());
+  for (size_t k = 0; k < ids.size(); ++k) {
+    const Term & t = frames_.lemma(ids[k]).term;
+    PropagationWorker & w = prop_workers_[k % num_workers];
+    queries[k] = w.to_worker->transfer_term(
+        solver_->make_term(Not, ts_.next(t)), BOOL);
+  }
+
+  // 1 iff the clause can be pushed
+  vector<char> pushed(ids.size(), 0);
+  vector<char> failed(num_workers, 0);
+  auto work = [&](size_t wid) {
+    PropagationWorker & w = prop_workers_[wid];
+    try {
+      // F[i] /\ T
+      w.solver->push();
+      for (size_t j = 0; j < w.frame_labels.size(); ++j) {
+        const Term & l = w.frame_labels[j];
+        w.solver->assert_formula(j < i ? w.solver->make_term(Not, l) : l);
+      }
+      for (size_t k = wid; k < ids.size(); k += num_workers) {
+        // /\ -t'
+        w.solver->push();
+        w.solver->assert_formula(queries[k]);
+        Result r = w.solver->check_sat();
+        pushed[k] = r.is_unsat();
+        w.solver->pop();
+      }
+      w.solver->pop();
+    }
+    catch (std::exception & e) {
+      // leaves the remaining clauses of this batch in F[i]
+      failed[wid] = 1;
+    }
+  };
+
+  vector<thread> threads;
+  for (size_t wid = 0; wid < num_workers; ++wid) {
+    threads.push_back(thread(work, wid));
+  }
+  for (auto & t : threads) {
+    t.join();
+  }
+
+  if (std::find(failed.begin(), failed.end(), 1) != failed.end()) {
+    // the context of a failed worker is unknown
+    // start over with fresh workers next time
+    logger.log(1, "IC3Base: a propagation worker failed, recreating them");
+    prop_workers_.clear();
+  }
+
+  size_t num_pushed = 0;
+  for (size_t k = 0; k < ids.size(); ++k) {
+    if (pushed[k]) {
+      IC3Formula f = frames_.lemma(ids[k]);
+      frames_.remove(ids[k]);
+      constrain_frame(i + 1, f, false);
+      num_pushed++;
+    }
+  }
+  logger.log(2,
+             "IC3Base: pushed {} of {} clauses from frame {}",
+             num_pushed,
+             ids.size(),
+             i);
+
+  return frames_.frame(i).empty();
+}
+
+void IC3Base::sync_propagation_workers()
+{
+  if (prop_workers_.empty()) {
+    // new workers start from the live lemmas only
+    frame_log_.clear();
+    for (size_t i = 1; i < frames_.size(); ++i) {
+      for (const auto & id : frames_.frame(i)) {
+        frame_log_.push_back({ i, frames_.lemma(id).term });
+      }
+    }
+
+    for (size_t wid = 0; wid < options_.ic3_propagation_threads_; ++wid) {
+      PropagationWorker w;
+      w.solver = create_solver(solver_->get_solver_enum());
+      w.solver->set_opt("incremental", "true");
+      w.to_worker = std::make_shared<TermTranslator>(w.solver);
+      w.solver->assert_formula(w.to_worker->transfer_term(ts_.trans(), BOOL));
+      w.num_synced = 0;
+      prop_workers_.push_back(w);
+    }
+  }
+
+  for (auto & w : prop_workers_) {
+    while (w.frame_labels.size() < frame_labels_.size()) {
+      w.frame_labels.push_back(w.to_worker->transfer_term(
+          frame_labels_[w.frame_labels.size()], BOOL));
+    }
+    for (; w.num_synced < frame_log_.size(); ++w.num_synced) {
+      const auto & elem = frame_log_[w.num_synced];
+      w.solver->assert_formula(
+          w.solver->make_term(Implies,
+                              w.frame_labels.at(elem.first),
+                              w.to_worker->transfer_term(elem.second, BOOL)));
+    }
+  }
+}
+
+bool IC3Base::ternary_lift(const IC3Formula & c,
+                           const TermVec & vars,
+                           TermVec & needed)
+{
+  needed.clear();
+  // constraints (e.g. invariants) are not simulated, so a lifted state
+  // might have no legal transition with these inputs
+  if (!options_.ic3_ternary_sim_ || !ts_.is_deterministic()) {
+    return false;
+  }
+
+  if (!ternary_sim_) {
+    ternary_sim_.reset(new TernarySimulator(ts_));
+  }
+
+  // the predecessor state and inputs from the model
+  for (const auto & v : ts_.statevars()) {
+    ternary_sim_->assign(v, solver_->get_value(v));
+  }
+  for (const auto & v : ts_.inputvars()) {
+    ternary_sim_->assign(v, solver_->get_value(v));
+  }
+
+  // the state updates of every state in the lifted cube
+  // (with the same inputs) must lead to c
+  if (!ternary_sim_->lift(vars, c.term, true, needed)) {
+    num_ternary_fallbacks_++;
+    return false;
+  }
+
+  if (needed.empty() && vars.size()) {
+    // c is reached from any state, but keep the cube non-trivial
+    needed.push_back(vars.back());
+  }
+  num_ternary_lifts_++;
+  return true;
 }
 
 void IC3Base::push_frame()
@@ -566,32 +1050,172 @@ void IC3Base::push_frame()
   frame_labels_.push_back(
       solver_->make_symbol("__frame_label_" + std::to_string(frames_.size()),
                            solver_->make_sort(BOOL)));
-  frames_.push_back({});
+  frames_.push_frame();
 }
 
 void IC3Base::constrain_frame(size_t i, const IC3Formula & constraint,
-                              bool new_constraint)
+                              bool new_constraint, bool publish)
 {
   assert(solver_context_ == 0);
   assert(i < frame_labels_.size());
 
   if (new_constraint) {
-    for (size_t j = 1; j <= i; ++j) { 
-      vector<IC3Formula> & Fj = frames_.at(j);
-      size_t k = 0;
-      for (size_t l = 0; l < Fj.size(); ++l) {
-        if (!subsumes(constraint, Fj[l])) {
-          Fj[k++] = Fj[l];
+    frames_.remove_subsumed(i, constraint);
+  }
+
+  assert(i > 0);  // there's a special case for frame 0
+
+  constrain_frame_label(i, constraint);
+  frames_.add(i, constraint);
+  if (options_.ic3_propagation_threads_ > 1) {
+    frame_log_.push_back({ i, constraint.term });
+  }
+
+  if (new_constraint && publish) {
+    publish_lemma(constraint.term);
+  }
+}
+
+void IC3Base::import_lemmas()
+{
+  size_t num_imported = add_external_lemmas(fetch_lemmas());
+  if (num_imported) {
+    logger.log(1, "IC3Base: imported {} lemmas", num_imported);
+  }
+}
+
+size_t IC3Base::add_external_lemmas(const TermVec & lemmas)
+{
+  size_t num_added = 0;
+  for (const auto & l : lemmas) {
+    // flatten the disjunction
+    TermVec children;
+    TermVec to_visit({ l });
+    while (to_visit.size()) {
+      Term t = to_visit.back();
+      to_visit.pop_back();
+      if (t->get_op() == Or) {
+        to_visit.insert(to_visit.end(), t->begin(), t->end());
+      } else {
+        children.push_back(t);
+      }
+    }
+
+    IC3Formula u = ic3formula_disjunction(children);
+    if (!ic3formula_check_valid(u)
+        || check_intersects_initial(solver_->make_term(Not, u.term))) {
+      continue;
+    }
+
+    // index 0 means it is not even inductive relative to F[0]
+    size_t idx = find_highest_frame(0, u);
+    if (idx) {
+      constrain_frame(idx, u, true, false);
+      num_added++;
+    }
+  }
+  return num_added;
+}
+
+void IC3Base::load_checkpoint()
+{
+  checkpoint_loaded_ = true;
+
+  const string & filename = options_.ic3_checkpoint_;
+  std::ifstream in(filename);
+  if (!in) {
+    logger.log(1, "IC3Base: no checkpoint to load from {}", filename);
+    return;
+  }
+
+  TermVec lemmas;
+  size_t num_lines = 0;
+  string line;
+  while (getline(in, line)) {
+    if (line.empty() || line[0] == ';') {
+      continue;
+    }
+    num_lines++;
+    try {
+      Term l = smtlib_to_term(line, ts_);
+      if (l->get_sort()->get_sort_kind() == BOOL) {
+        lemmas.push_back(l);
+      }
+    }
+    catch (std::exception & e) {
+      // e.g. a variable was removed or changed its sort
+      logger.log(3, "IC3Base: dropping checkpoint lemma {}", e.what());
+    }
+  }
+
+  size_t num_added = add_external_lemmas(lemmas);
+  logger.log(1,
+             "IC3Base: loaded {} lemmas from checkpoint {}, dropped {}",
+             num_added,
+             filename,
+             num_lines - num_added);
+}
+
+void IC3Base::save_checkpoint() const
+{
+  const string & filename = options_.ic3_checkpoint_;
+  if (filename.empty()) {
+    return;
+  }
+
+  // write to a temporary file first, so a kill while writing
+  // doesn't destroy the previous checkpoint
+  // the name is unique to this process and thread, portfolio workers
+  // can save to the same checkpoint concurrently
+  string tmp_filename =
+      filename + "." + std::to_string(getpid()) + "."
+      + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()))
+      + ".tmp";
+  size_t num_saved = 0;
+  {
+    std::ofstream out(tmp_filename);
+    if (!out) {
+      logger.log(1, "IC3Base: can't write checkpoint {}", tmp_filename);
+      return;
+    }
+    out << "; pono ic3 checkpoint, one lemma per line" << std::endl;
+    for (size_t i = 1; i < frames_.size(); ++i) {
+      out << "; frame " << i << "\n";
+      for (size_t id : frames_.frame(i)) {
+        try {
+          out << term_to_smtlib(frames_.lemma(id).term) << "\n";
+          num_saved++;
+        }
+        catch (PonoException & e) {
+          logger.log(3, "IC3Base: not saving lemma {}", e.what());
         }
       }
-      Fj.resize(k);
+    }
+    if (!out) {
+      logger.log(1, "IC3Base: failed to write checkpoint {}", tmp_filename);
+      out.close();
+      std::remove(tmp_filename.c_str());
+      return;
     }
   }
 
-  assert(i > 0);  // there's a special case for frame 0
+  if (std::rename(tmp_filename.c_str(), filename.c_str())) {
+    logger.log(1, "IC3Base: can't replace checkpoint {}", filename);
+    std::remove(tmp_filename.c_str());
+    return;
+  }
+  logger.log(2, "IC3Base: saved {} lemmas to {}", num_saved, filename);
+}
 
-  constrain_frame_label(i, constraint);
-  frames_.at(i).push_back(constraint);
+void IC3Base::checkpoint_on_sigterm() const
+{
+  if (!sigterm_received || options_.ic3_checkpoint_.empty()) {
+    return;
+  }
+  logger.log(1, "IC3Base: received SIGTERM, saving checkpoint");
+  save_checkpoint();
+  std::signal(SIGTERM, SIG_DFL);
+  std::raise(SIGTERM);
 }
 
 void IC3Base::constrain_frame_label(size_t i, const IC3Formula & constraint)
@@ -600,6 +1224,7 @@ void IC3Base::constrain_frame_label(size_t i, const IC3Formula & constraint)
 
   solver_->assert_formula(
       solver_->make_term(Implies, frame_labels_.at(i), constraint.term));
+  num_lemmas_since_reset_++;
 }
 
 void IC3Base::assert_frame_labels(size_t i) const
@@ -631,8 +1256,8 @@ Term IC3Base::get_frame_term(size_t i) const
 
   Term res = solver_true_;
   for (size_t j = i; j < frames_.size(); ++j) {
-    for (const auto &u : frames_[j]) {
-      res = solver_->make_term(And, res, u.term);
+    for (const auto & id : frames_.frame(j)) {
+      res = solver_->make_term(And, res, frames_.lemma(id).term);
     }
   }
   return res;
@@ -737,6 +1362,59 @@ Term IC3Base::make_and(TermVec vec, SmtSolver slv) const
   return res;
 }
 
+bool IC3Base::should_reset_solver()
+{
+  if (failed_to_reset_solver_) {
+    return false;
+  }
+
+  if (options_.ic3_reset_interval_
+      && num_check_sat_since_reset_ >= options_.ic3_reset_interval_) {
+    logger.log(2, "IC3Base: resetting after {} check-sat calls",
+               num_check_sat_since_reset_);
+    return true;
+  }
+
+  // don't bother for a few lemmas, the reset would cost more
+  size_t num_live = frames_.num_lemmas();
+  if (options_.ic3_reset_dead_lemmas_ && num_lemmas_since_reset_ >= 1000
+      && num_lemmas_since_reset_ > num_live
+      && 100 * (num_lemmas_since_reset_ - num_live)
+             > options_.ic3_reset_dead_lemmas_ * num_lemmas_since_reset_) {
+    logger.log(2,
+               "IC3Base: resetting with {} live lemmas out of {} asserted",
+               num_live,
+               num_lemmas_since_reset_);
+    return true;
+  }
+
+  // reading the memory usage is a system call, only do it once in a while
+  if (options_.ic3_reset_memory_
+      && num_check_sat_since_reset_ >= rss_checked_at_ + 100) {
+    rss_checked_at_ = num_check_sat_since_reset_;
+    size_t rss = resident_memory_mb();
+    if (rss > rss_at_reset_ + options_.ic3_reset_memory_) {
+      logger.log(2,
+                 "IC3Base: resetting with {} MB resident, {} MB after the "
+                 "last reset",
+                 rss,
+                 rss_at_reset_);
+      return true;
+    }
+  }
+
+  if (options_.ic3_reset_time_) {
+    auto elapsed = std::chrono::steady_clock::now() - last_reset_time_;
+    if (elapsed >= std::chrono::seconds(options_.ic3_reset_time_)) {
+      logger.log(2, "IC3Base: resetting after {} seconds",
+                 options_.ic3_reset_time_);
+      return true;
+    }
+  }
+
+  return false;
+}
+
 void IC3Base::reset_solver()
 {
   assert(solver_context_ == 0);
@@ -760,11 +1438,32 @@ void IC3Base::reset_solver()
     solver_->assert_formula(
         solver_->make_term(Implies, trans_label_, ts_.trans()));
 
+    // only the live lemmas, one assertion per frame
+    num_lemmas_since_reset_ = 0;
+    TermVec lemmas;
     for (size_t i = 0; i < frames_.size(); ++i) {
-      for (const auto & constraint : frames_.at(i)) {
-        constrain_frame_label(i, constraint);
+      lemmas.clear();
+      for (const auto & id : frames_.frame(i)) {
+        lemmas.push_back(frames_.lemma(id).term);
+      }
+      if (lemmas.size()) {
+        solver_->assert_formula(solver_->make_term(
+            Implies, frame_labels_.at(i), make_and(lemmas)));
+        num_lemmas_since_reset_ += lemmas.size();
       }
     }
+
+    reassert_base_constraints();
+
+    // the negations of the disabled labels are gone
+    // nothing refers to the unused labels anymore, forget them
+    num_disabled_labels_ = 0;
+    collect_labels(false);
+
+    // the workers replay frame_log_, which still has the dead lemmas
+    // they are rebuilt from the live frames when needed again
+    prop_workers_.clear();
+    frame_log_.clear();
   }
   catch (SmtException & e) {
     logger.log(1,
@@ -774,36 +1473,79 @@ void IC3Base::reset_solver()
   }
 
   num_check_sat_since_reset_ = 0;
+  rss_checked_at_ = 0;
+  if (options_.ic3_reset_memory_) {
+    rss_at_reset_ = resident_memory_mb();
+  }
+  last_reset_time_ = std::chrono::steady_clock::now();
 }
 
 Term IC3Base::label(const Term & t)
 {
   auto it = labels_.find(t);
   if (it != labels_.end()) {
-    return labels_.at(t);
+    it->second.refs++;
+    return it->second.lit;
   }
 
-  unsigned i = 0;
   Term l;
   while (true) {
     try {
-      l = solver_->make_symbol(
-          "assump_" + std::to_string(t->hash()) + "_" + std::to_string(i),
-          solver_->make_sort(BOOL));
+      l = solver_->make_symbol("assump_" + std::to_string(t->hash()) + "_"
+                                   + std::to_string(num_labels_created_++),
+                               solver_->make_sort(BOOL));
       break;
     }
     catch (IncorrectUsageException & e) {
-      ++i;
+      // name is taken, try the next one
     }
     catch (SmtException & e) {
       throw e;
     }
   }
 
-  labels_[t] = l;
+  labels_[t] = { l, 1 };
+  num_labels_since_gc_++;
   return l;
 }
 
+void IC3Base::release_labels(const TermVec & terms)
+{
+  for (const auto & t : terms) {
+    auto it = labels_.find(t);
+    assert(it != labels_.end());
+    assert(it->second.refs);
+    it->second.refs--;
+  }
+}
+
+void IC3Base::collect_labels(bool disable)
+{
+  assert(solver_context_ == 0);
+  size_t num_collected = 0;
+  for (auto it = labels_.begin(); it != labels_.end();) {
+    if (it->second.refs) {
+      ++it;
+      continue;
+    }
+    if (disable) {
+      // the label can't be assumed anymore, which lets the
+      // solver simplify away the clauses it learned with it
+      solver_->assert_formula(solver_->make_term(Not, it->second.lit));
+      num_disabled_labels_++;
+    }
+    it = labels_.erase(it);
+    num_collected++;
+  }
+  num_labels_since_gc_ = 0;
+  logger.log(2,
+             "IC3Base: collected {} unused labels, {} remaining, {} disabled "
+             "since the last reset",
+             num_collected,
+             labels_.size(),
+             num_disabled_labels_);
+}
+
 smt::Term IC3Base::smart_not(const Term & t) const
 {
   const Op &op = t->get_op();
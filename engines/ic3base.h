@@ -38,9 +38,9 @@
 **             manipulating an IC3Formula if the defaults are not right
 **           - implement abstract() and refine() if this is a CEGAR
 **             flavor of IC3
-**           - override reset_solver if you need to add back in constraints
-**             to the reset solver that aren't handled by the default
-*8             implementation
+**           - override reassert_base_constraints if you add constraints
+**             to the solver at context 0 that aren't handled by the
+**             default reset_solver (init, trans and the frames)
 **
 **        Important Notes:
 **           - be sure to use [push/pop]_solver_context instead of using
@@ -54,9 +54,15 @@
 #pragma once
 
 #include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <deque>
 #include <queue>
+#include <unordered_map>
 
+#include "core/ternary_sim.h"
 #include "engines/prover.h"
+#include "smt-switch/term_translator.h"
 #include "smt-switch/utils.h"
 
 namespace pono {
@@ -97,11 +103,11 @@ struct IC3Formula
 struct ProofGoal
 {
   // based on open-source ic3ia ProofObligation
-  IC3Formula target;
+  const IC3Formula * target;  ///< owned (and shared) by the ProofGoalQueue
   size_t idx;
   const ProofGoal * next;
 
-  ProofGoal(IC3Formula u, size_t i, const ProofGoal * n)
+  ProofGoal(const IC3Formula * u, size_t i, const ProofGoal * n)
       : target(u), idx(i), next(n)
   {
   }
@@ -125,30 +131,80 @@ struct ProofGoalOrder
 /**
  * Priority queue of proof obligations borrowed from open-source ic3ia
  * implementation
+ * Proof goals live in an arena owned by the queue: they stay valid
+ * (e.g. for following next pointers) until clear(), which recycles
+ * their slots for the next goals. Targets are interned, so goals for the
+ * same formula share a single copy of it.
  */
 class ProofGoalQueue
 {
  public:
-  ~ProofGoalQueue() { clear(); }
+  ProofGoalQueue() : num_resident_(0), num_created_(0), num_reused_(0) {}
 
+  /** Removes all proof goals
+   *  invalidates all pointers to them, but keeps the memory for reuse
+   */
   void clear()
   {
-    for (auto p : store_) {
-      delete p;
-    }
-    store_.clear();
+    num_resident_ = 0;
+    formulas_.clear();
     while (!queue_.empty()) {
       queue_.pop();
     }
   }
 
+  /** Creates a proof goal without adding it to the queue
+   *  @return the new proof goal, valid until clear()
+   */
+  ProofGoal * make(const IC3Formula & c,
+                   unsigned int t,
+                   const ProofGoal * n = NULL)
+  {
+    const IC3Formula * target = &formulas_.emplace(c.term, c).first->second;
+    num_created_++;
+    if (num_resident_ < arena_.size()) {
+      ProofGoal & pg = arena_[num_resident_++];
+      pg = ProofGoal(target, t, n);
+      return &pg;
+    }
+    arena_.emplace_back(target, t, n);
+    num_resident_++;
+    return &arena_.back();
+  }
+
   void push_new(const IC3Formula & c,
                 unsigned int t,
                 const ProofGoal * n = NULL)
   {
-    ProofGoal * pg = new ProofGoal(c, t, n);
-    push(pg);
-    store_.push_back(pg);
+    push(make(c, t, n));
+  }
+
+  /** Adds a proof goal that was removed from the queue again
+   *  at a (higher) frame, instead of creating a new one
+   *  @param p a proof goal of this queue that is not in the queue
+   *  @param t the new frame of the proof goal
+   */
+  void reschedule(ProofGoal * p, unsigned int t)
+  {
+    assert(t >= p->idx);
+    p->idx = t;
+    num_reused_++;
+    push(p);
+  }
+
+  /** Removes up to n proof goals with the same frame as the top one
+   *  @param n the maximum number of proof goals
+   *  @return the removed proof goals, starting with the top one
+   */
+  std::vector<ProofGoal *> pop_batch(size_t n)
+  {
+    std::vector<ProofGoal *> res;
+    while (!queue_.empty() && res.size() < n
+           && (res.empty() || queue_.top()->idx == res[0]->idx)) {
+      res.push_back(queue_.top());
+      queue_.pop();
+    }
+    return res;
   }
 
   void push(ProofGoal * p) { queue_.push(p); }
@@ -156,12 +212,98 @@ class ProofGoalQueue
   void pop() { queue_.pop(); }
   bool empty() const { return queue_.empty(); }
 
+  /** @return the number of proof goals created (over all clears) */
+  size_t num_created() const { return num_created_; }
+  /** @return the number of proof goals rescheduled (over all clears) */
+  size_t num_reused() const { return num_reused_; }
+  /** @return the number of proof goals in the arena since the last clear */
+  size_t num_resident() const { return num_resident_; }
+
  private:
   typedef std::
       priority_queue<ProofGoal *, std::vector<ProofGoal *>, ProofGoalOrder>
           Queue;
   Queue queue_;
-  std::vector<ProofGoal *> store_;
+  std::deque<ProofGoal> arena_;  ///< stable addresses, slots are recycled
+  size_t num_resident_;          ///< slots of arena_ in use
+  std::unordered_map<smt::Term, IC3Formula> formulas_;  ///< interned targets
+
+  size_t num_created_;
+  size_t num_reused_;
+};
+
+/**
+ * Lemmas of the IC3 frames
+ * Each lemma (a disjunction) is kept only in the highest frame where it
+ * is known to hold. Lemmas are indexed by literal occurrence lists and a
+ * 64-bit signature of their literals, so that subsumption queries only
+ * visit lemmas that share a literal with the query and the signature
+ * check rules out most of those without comparing literals.
+ * Lemma ids are stable until the next push_frame.
+ */
+class FrameDB
+{
+ public:
+  FrameDB() : num_dead_(0) {}
+
+  /** Removes all frames and lemmas */
+  void clear();
+
+  /** Adds an empty frame at the end
+   *  and drops the storage of removed lemmas if there are many
+   */
+  void push_frame();
+
+  /** @return the number of frames */
+  size_t size() const { return frames_.size(); }
+
+  /** @return the ids of the lemmas in frame i */
+  const std::vector<size_t> & frame(size_t i) const { return frames_.at(i); }
+
+  /** @return the lemma with the given id */
+  const IC3Formula & lemma(size_t id) const { return entries_.at(id).lemma; }
+
+  /** Adds a lemma to frame i
+   *  @return the id of the lemma
+   */
+  size_t add(size_t i, const IC3Formula & u);
+
+  /** Removes the lemma with the given id from its frame */
+  void remove(size_t id);
+
+  /** Removes the lemmas in frames 1 through i that are subsumed by u
+   *  @return the number of lemmas removed
+   */
+  size_t remove_subsumed(size_t i, const IC3Formula & u);
+
+  /** @return true iff a lemma in frame i or higher subsumes u */
+  bool subsumed(size_t i, const IC3Formula & u) const;
+
+  /** @return the number of lemmas in all frames */
+  size_t num_lemmas() const { return entries_.size() - num_dead_; }
+
+ protected:
+  struct Entry
+  {
+    IC3Formula lemma;
+    uint64_t sig;  ///< one bit per literal (hashed)
+    size_t frame;
+    size_t pos;  ///< position in frames_[frame]
+    bool alive;
+  };
+
+  /** Drops removed lemmas, this changes the ids */
+  void compact();
+
+  void index(size_t id);
+
+  std::vector<Entry> entries_;
+  std::vector<std::vector<size_t>> frames_;
+  ///< literal -> lemmas containing it (may contain removed lemmas)
+  std::unordered_map<smt::Term, std::vector<size_t>> occurs_;
+  ///< literal -> lemmas whose first literal it is
+  std::unordered_map<smt::Term, std::vector<size_t>> first_occurs_;
+  size_t num_dead_;  ///< number of removed lemmas still in entries_
 };
 
 class IC3Base : public Prover
@@ -198,19 +340,29 @@ class IC3Base : public Prover
 
   size_t num_check_sat_since_reset_;
 
+  ///< number of lemmas asserted on solver_ since the last reset
+  ///< (including the ones that were subsumed or pushed since)
+  size_t num_lemmas_since_reset_;
+  size_t rss_at_reset_;  ///< resident memory (MB) after the last reset
+  size_t rss_checked_at_;  ///< value of num_check_sat_since_reset_ when
+                           ///< the memory was last checked
+  std::chrono::steady_clock::time_point last_reset_time_;
+
   bool failed_to_reset_solver_;  ///< some solvers don't support reset
                                  ///< assertions. Stop trying for those solvers.
 
   const ProofGoal * cex_pg_;  ///< if a proof goal is traced back to init
                               ///< this gets set to the first proof goal
                               ///< in the trace
-                              ///< otherwise starts null, can check that
-                              ///< cex_pg_.target.term is a nullptr
+                              ///< otherwise starts null
+                              ///< points into proof_goals_ (not owned)
 
   ///< the frames data structure.
-  ///< a vector of the given Unit template
-  ///< which changes depending on the implementation
-  std::vector<std::vector<IC3Formula>> frames_;
+  ///< holds the IC3Formulas of the given flavor of IC3
+  ///< (e.g. clauses) indexed for subsumption checks
+  FrameDB frames_;
+
+  bool checkpoint_loaded_;  ///< lemmas from options_.ic3_checkpoint_ loaded
 
   ///< priority queue of outstanding proof goals
   ProofGoalQueue proof_goals_;
@@ -219,7 +371,38 @@ class IC3Base : public Prover
   smt::Term init_label_;       ///< label to activate init
   smt::Term trans_label_;      ///< label to activate trans
   smt::TermVec frame_labels_;  ///< labels to activate frames
-  smt::UnorderedTermMap labels_;  //< labels for unsat cores
+  /** An activation literal for unsat cores (see label) */
+  struct Label
+  {
+    smt::Term lit;
+    size_t refs;  ///< number of label calls not released yet
+  };
+  std::unordered_map<smt::Term, Label> labels_;  //< labels for unsat cores
+  size_t num_labels_since_gc_;  ///< labels created since the last collection
+  size_t num_disabled_labels_;  ///< negated labels asserted since the reset
+  size_t num_labels_created_;  ///< all labels, to make unique names
+
+  /** A solver for checking relative inductiveness during propagation
+   *  it has trans and its own copy of the frame labels
+   *  (see propagate_parallel)
+   */
+  struct PropagationWorker
+  {
+    smt::SmtSolver solver;
+    std::shared_ptr<smt::TermTranslator> to_worker;
+    smt::TermVec frame_labels;
+    size_t num_synced;  ///< number of entries of frame_log_ asserted
+  };
+  std::vector<PropagationWorker> prop_workers_;
+  ///< (i, constraint) for every constraint added to frame i since the
+  ///< workers were created (they start from the live lemmas in frames_)
+  std::vector<std::pair<size_t, smt::Term>> frame_log_;
+
+  ///< lifts predecessors without the solver (see ternary_lift)
+  ///< created on first use
+  std::unique_ptr<TernarySimulator> ternary_sim_;
+  size_t num_ternary_lifts_;      ///< predecessors lifted by ternary_sim_
+  size_t num_ternary_fallbacks_;  ///< predecessors it could not lift
 
   // useful terms
   smt::Term solver_true_;
@@ -288,6 +471,11 @@ class IC3Base : public Prover
    */
   virtual IC3Formula generalize_predecessor(size_t i, const IC3Formula & c) = 0;
 
+  ///< how many predecessors were already generalized from the current model
+  ///< (see options_.ic3_num_predecessors_). generalize_predecessor can use
+  ///< it to vary the literal order
+  size_t pregen_round_;
+
   /** Checks if every thing in the current transition system is supported
    *  by the current instantiation
    *  throws a PonoException with a relevant message if not.
@@ -403,12 +591,51 @@ class IC3Base : public Prover
    */
   bool block_all();
 
+  /** Attempt to block the proof goals at the top of the queue that share
+   *  a frame (up to options_.ic3_batch_goals_) with a single query
+   *  F[i-1] /\ T /\ (a_1 \/ ... \/ a_n) where a_j -> (!c_j /\ c_j')
+   *  If it is unsat, all of them are blocked without querying them one by
+   *  one. Otherwise, a proof goal with a predecessor is extended.
+   *  @return false if there were less than two proof goals to batch
+   *          (then the queue is unchanged)
+   */
+  bool block_batch();
+
+  /** Computes the predecessors of c from the current model of solver_
+   *  (generalized if options_.ic3_pregen_)
+   *  @requires the solver_ context is satisfiable with a model in
+   *            F[i-1] /\ !c /\ T /\ c'
+   *  @param i the frame number of c
+   *  @param c the proof goal formula
+   *  @param out set to the distinct predecessors
+   *         (up to options_.ic3_num_predecessors_)
+   */
+  void get_predecessors(size_t i,
+                        const IC3Formula & c,
+                        std::vector<IC3Formula> & out);
+
+  /** @requires c is inductive relative to F[i-1]
+   *  @return the blocking units for c at frame i (generalized if
+   *          options_.ic3_indgen_)
+   */
+  std::vector<IC3Formula> blocking_units(size_t i, const IC3Formula & c);
+
+  /** Adds the blocking units of a proof goal to the highest frames
+   *  possible and reschedules the proof goal after the lowest of them
+   *  @param pg the blocked proof goal, already removed from the queue
+   *  @param units its blocking units
+   */
+  void add_blocking_units(ProofGoal * pg,
+                          const std::vector<IC3Formula> & units);
+
   /** Attempt to block the given proof goal
-   *  @param pg the proof goal
-   *  @return true iff the proof goal was blocked,
+   *  @param pg the proof goal, expected at the top of the proof goals
+   *  @return true iff the proof goal was blocked, then it is removed from
+   *          the proof goals (and rescheduled at the next frame it is not
+   *          blocked in, if there is one),
    *          otherwise a new proof goal was added to the proof goals
    */
-  bool block(const ProofGoal * pg);
+  bool block(ProofGoal * pg);
 
   /** Check if the given proof goal is already blocked
    *  @param pg the proof goal
@@ -423,6 +650,40 @@ class IC3Base : public Prover
    */
   bool propagate(size_t i);
 
+  /** Version of propagate that splits the clauses of frame i into
+   *  batches checked concurrently by options_.ic3_propagation_threads_
+   *  worker solvers
+   *  The workers only know ts_.trans() and the frames, so flavors that
+   *  add more constraints to trans_label_ may push fewer clauses
+   *  (this is still sound)
+   *  @param i the frame index to propagate
+   *  @return true iff all the clauses are propagated
+   */
+  bool propagate_parallel(size_t i);
+
+  /** Creates the propagation workers (if needed) and asserts
+   *  the frame constraints they don't have yet
+   *  The workers are dropped on reset_solver and then recreated
+   *  from the live lemmas
+   */
+  void sync_propagation_workers();
+
+  /** Generalizes the predecessor in the current model of solver_
+   *  with ternary simulation of the state updates
+   *  Only for deterministic systems (functional and without
+   *  constraints) with options_.ic3_ternary_sim_
+   *  @param c the cube the predecessor reaches in one step
+   *  @param vars the state variables of the predecessor cube, in the order
+   *         they should be dropped
+   *  @param needed set to the variables of vars that are needed to reach c
+   *         (never empty if vars isn't)
+   *  @return false if ternary simulation can't show that c is reached
+   *          then the caller should fall back to the solver
+   */
+  bool ternary_lift(const IC3Formula & c,
+                    const smt::TermVec & vars,
+                    smt::TermVec & needed);
+
   /** Add a new frame */
   void push_frame();
 
@@ -432,9 +693,47 @@ class IC3Base : public Prover
    *  @param new_contraint true iff the constraint is a
    *         newly learned blocking constraint. In true, then subsumption check
    *         is performed
+   *  @param publish if true and new_constraint is true, the constraint is
+   *         published on the lemma bus (if there is one)
    */
   void constrain_frame(size_t i, const IC3Formula & constraint,
-                       bool new_constraint=true);
+                       bool new_constraint=true, bool publish=true);
+
+  /** Imports lemmas from the lemma bus (if there is one)
+   *  Each lemma must be a valid IC3Formula (as a disjunction) for this
+   *  flavor of IC3, hold in the initial states and be inductive relative
+   *  to F[0]. Accepted lemmas are added to the highest frame they can be
+   *  pushed to.
+   *  Should only be called at a safe point, e.g. after propagation
+   */
+  void import_lemmas();
+
+  /** Adds lemmas that were learned elsewhere (lemma bus or checkpoint)
+   *  Each lemma is checked like in import_lemmas and dropped if it fails
+   *  @param lemmas the lemmas (disjunctions) over current state variables
+   *  @return the number of lemmas that were added
+   */
+  size_t add_external_lemmas(const smt::TermVec & lemmas);
+
+  /** Loads the lemmas saved in the options_.ic3_checkpoint_ file
+   *  (if it exists) with add_external_lemmas
+   *  Lemmas that can't be parsed (e.g. the variable was renamed) are
+   *  dropped as well
+   *  Should only be called after step_0
+   */
+  void load_checkpoint();
+
+  /** Saves the lemmas of all frames to the options_.ic3_checkpoint_ file
+   *  as SMT-LIB terms, one per line. Every lemma holds at the time it is
+   *  saved, so it is safe to call this in the middle of blocking.
+   *  The file is replaced atomically.
+   */
+  void save_checkpoint() const;
+
+  /** If SIGTERM was received since check_until started,
+   *  saves a checkpoint and terminates the process with SIGTERM
+   */
+  void checkpoint_on_sigterm() const;
 
   /** Adds an implication frame_label_[i] -> constraint
    *  used as a helper in constrain_frame and when resetting solver
@@ -555,21 +854,52 @@ class IC3Base : public Prover
     return solver_->check_sat_assuming(assumps);
   }
 
+  /** Decides whether to reset the solver before the next proof goal
+   *  The default policy resets when any of the enabled limits is exceeded:
+   *  check-sat calls, percentage of dead lemmas, memory growth and time
+   *  since the last reset (see the ic3-reset-* options)
+   *  Override it for a different policy
+   *  @return true iff reset_solver should be called
+   */
+  virtual bool should_reset_solver();
+
   /** Attempts to reset the solver and re-add constraints
    *  NOTE: not all solvers support reset_assertions, in which case the
    * exception is just caught and things continue on as normal
    */
   virtual void reset_solver();
 
+  /** Re-adds the constraints a derived class asserted at context 0
+   *  Called by reset_solver after init, trans and the frames are back
+   *  The default implementation does nothing
+   */
+  virtual void reassert_base_constraints() {}
+
   /** Create a boolean label for a given term
-   *  These are cached in labels_
+   *  These are cached in labels_ and reference counted
    *  good for using unsat cores
+   *  Every call must be matched by release_labels once the
+   *  query that assumes the label is done
    *
    *  @param t a boolean formula to create a label for
    *  @return the indicator variable label for this term
    */
   smt::Term label(const smt::Term & t);
 
+  /** Releases one reference to the labels of the given terms
+   *  @param terms the terms that were passed to label
+   */
+  void release_labels(const smt::TermVec & terms);
+
+  /** Forgets the labels without references
+   *  so that label creates a new one if the term is needed again
+   *  Called every options_.ic3_label_gc_ new labels and on reset_solver
+   *  @param disable if true, the negations of the forgotten labels are
+   *         asserted. Not needed right after a reset, when no assertion
+   *         refers to them. reset_solver drops these negations again
+   */
+  void collect_labels(bool disable);
+
   /** Negates a term by stripping the leading Not if it's there,
    ** or applying Not if the term is not already negated.
    */
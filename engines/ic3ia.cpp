@@ -201,13 +201,13 @@ void IC3IA::abstract()
 RefineResult IC3IA::refine()
 {
   // recover the counterexample trace
-  assert(check_intersects_initial(cex_pg_->target.term));
-  TermVec cex({ cex_pg_->target.term });
+  assert(check_intersects_initial(cex_pg_->target->term));
+  TermVec cex({ cex_pg_->target->term });
   const ProofGoal * tmp = cex_pg_;
   while (tmp->next) {
     tmp = tmp->next;
-    cex.push_back(tmp->target.term);
-    assert(ts_.only_curr(tmp->target.term));
+    cex.push_back(tmp->target->term);
+    assert(ts_.only_curr(tmp->target->term));
   }
 
   if (cex.size() == 1) {
@@ -316,6 +316,7 @@ bool IC3IA::add_predicate(const Term & pred)
   predset_.insert(pred);
   // add predicate to abstraction and get the new constraint
   Term predabs_rel = ia_.add_predicate(pred);
+  predabs_rels_.push_back(predabs_rel);
   // refine the transition relation incrementally
   // by adding a new constraint
   assert(!solver_context_);  // should be at context 0
@@ -324,6 +325,16 @@ bool IC3IA::add_predicate(const Term & pred)
   return true;
 }
 
+void IC3IA::reassert_base_constraints()
+{
+  // lost on a solver reset, otherwise the abstraction
+  // would forget all the predicates added by refinement
+  assert(!solver_context_);
+  for (const auto & rel : predabs_rels_) {
+    solver_->assert_formula(solver_->make_term(Implies, trans_label_, rel));
+  }
+}
+
 void IC3IA::register_symbol_mappings(size_t i)
 {
   if (i < longest_cex_length_) {
@@ -61,6 +61,8 @@ class IC3IA : public IC3
   smt::UnorderedTermSet predset_;  ///< set of current predicates
   // useful for checking if predicate has been added already
   // also available as a vector in ia_.predicates()
+  smt::TermVec predabs_rels_;  ///< refinements of trans_label_, one for
+                               ///< each predicate (see add_predicate)
 
   smt::SmtSolver interpolator_;  ///< interpolator for refinement
   smt::TermTranslator
@@ -89,6 +91,9 @@ class IC3IA : public IC3
 
   RefineResult refine() override;
 
+  /** Re-adds the refinements of trans_label_ in predabs_rels_ */
+  void reassert_base_constraints() override;
+
   // specific to IC3IA
 
   /** Adds predicate to abstraction
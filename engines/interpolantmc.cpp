@@ -56,7 +56,7 @@ void InterpolantMC::initialize()
   // (only time 1 because Craig Interpolant has to share symbols between A and
   // B)
   UnorderedTermMap & cache = to_solver_.get_cache();
-  Term tmp1;
+  Term tmp0, tmp1;
   for (const auto &s : ts_.statevars()) {
     tmp1 = unroller_.at_time(s, 1);
     cache[to_interpolator_.transfer_term(tmp1)] = tmp1;
@@ -66,6 +66,20 @@ void InterpolantMC::initialize()
     cache[to_interpolator_.transfer_term(tmp1)] = tmp1;
   }
 
+  if (options_.interp_incremental_) {
+    // interpolants are moved to time 0 in interpolator_ instead
+    // so the symbols at time 0 are needed as well
+    UnorderedTermSet vars = ts_.statevars();
+    vars.insert(ts_.inputvars().begin(), ts_.inputvars().end());
+    for (const auto &v : vars) {
+      tmp0 = unroller_.at_time(v, 0);
+      tmp1 = unroller_.at_time(v, 1);
+      Term int_tmp0 = to_interpolator_.transfer_term(tmp0);
+      cache[int_tmp0] = tmp0;
+      int_to_time0_[to_interpolator_.transfer_term(tmp1)] = int_tmp0;
+    }
+  }
+
   // need to copy over UF as well
   UnorderedTermSet free_symbols;
   get_free_symbols(bad_, free_symbols);
@@ -82,6 +96,13 @@ void InterpolantMC::initialize()
   transA_ = unroller_.at_time(ts_.trans(), 0);
   transB_ = solver_->make_term(true);
   bad_disjuncts_ = solver_->make_term(false);
+
+  if (options_.interp_incremental_) {
+    int_init0_ = to_interpolator_.transfer_term(init0_);
+    int_transA_ = to_interpolator_.transfer_term(transA_);
+    int_transB_ = interpolator_->make_term(true);
+    int_bad_disjuncts_ = interpolator_->make_term(false);
+  }
 }
 
 ProverResult InterpolantMC::check_until(int k)
@@ -90,7 +111,9 @@ ProverResult InterpolantMC::check_until(int k)
 
   try {
     for (int i = 0; i <= k; ++i) {
-      if (step(i)) {
+      bool proved = options_.interp_incremental_ ? step_incremental(i)
+                                                 : step(i);
+      if (proved) {
         return ProverResult::TRUE;
       } else if (concrete_cex_) {
         compute_witness();
@@ -155,19 +178,7 @@ bool InterpolantMC::step(int i)
     } else if (R == init0_) {
       // found a concrete counter example
       // replay it in the solver with model generation
-      concrete_cex_ = true;
-      reset_assertions(solver_);
-
-      Term solver_trans = solver_->make_term(And, transA_, transB_);
-      solver_->assert_formula(solver_->make_term(
-          And, init0_, solver_->make_term(And, solver_trans, bad_i)));
-
-      Result r = solver_->check_sat();
-      if (!r.is_sat()) {
-        throw PonoException("Internal error: Expecting satisfiable result");
-      }
-      // increment reached_k_ so that witness goes up to the bad state
-      ++reached_k_;
+      replay_cex(bad_i);
       return false;
     }
     else if (r.is_unknown())
@@ -188,6 +199,102 @@ bool InterpolantMC::step(int i)
   return false;
 }
 
+bool InterpolantMC::step_incremental(int i)
+{
+  if (i <= reached_k_) {
+    return false;
+  }
+
+  logger.log(1, "Checking interpolation at bound: {}", i);
+
+  if (i == 0) {
+    return step_0();
+  }
+
+  // only the new frame is translated
+  Term bad_i = unroller_.at_time(bad_, i);
+  int_bad_disjuncts_ = interpolator_->make_term(
+      Or, int_bad_disjuncts_, to_interpolator_.transfer_term(bad_i));
+  Term int_B = interpolator_->make_term(And, int_transB_, int_bad_disjuncts_);
+
+  Term R = init0_;
+  Term int_R = int_init0_;
+  // solver_ holds !R at this level, see check below
+  reset_assertions(solver_);
+  solver_->push();
+  solver_->assert_formula(solver_->make_term(Not, R));
+
+  while (true) {
+    Term int_Ri;
+    Result r = interpolator_->get_interpolant(
+        interpolator_->make_term(And, int_R, int_transA_), int_B, int_Ri);
+
+    if (r.is_unsat()) {
+      // map Ri to time 0 before leaving the interpolator
+      int_Ri = interpolator_->substitute(int_Ri, int_to_time0_);
+      Term Ri = to_solver_.transfer_term(int_Ri);
+
+      // Ri |= R iff Ri /\ !R is unsat
+      solver_->push();
+      solver_->assert_formula(Ri);
+      Result er = solver_->check_sat();
+      solver_->pop();
+      assert(er.is_unsat() || er.is_sat());
+
+      if (er.is_unsat()) {
+        logger.log(1, "Found a proof at bound: {}", i);
+        invar_ = unroller_.untime(R);
+        solver_->pop();
+        return true;
+      }
+
+      logger.log(1, "Extending initial states.");
+      logger.log(3, "Using interpolant: {}", Ri);
+      R = solver_->make_term(Or, R, Ri);
+      int_R = interpolator_->make_term(Or, int_R, int_Ri);
+      // !(R \/ Ri) = !R /\ !Ri
+      solver_->assert_formula(solver_->make_term(Not, Ri));
+    } else if (R == init0_) {
+      solver_->pop();
+      replay_cex(bad_i);
+      return false;
+    } else if (r.is_unknown()) {
+      throw PonoException("Interpolant generation failed.");
+    } else {
+      break;
+    }
+  }
+  solver_->pop();
+
+  assert(i > 0);
+  Term trans_i = unroller_.at_time(ts_.trans(), i);
+  transB_ = solver_->make_term(And, transB_, trans_i);
+  int_transB_ = interpolator_->make_term(
+      And, int_transB_, to_interpolator_.transfer_term(trans_i));
+  ++reached_k_;
+
+  return false;
+}
+
+void InterpolantMC::replay_cex(const Term & bad_i)
+{
+  // found a concrete counter example
+  // replay it in the solver with model generation
+  concrete_cex_ = true;
+  reset_assertions(solver_);
+
+  Term solver_trans = solver_->make_term(And, transA_, transB_);
+  solver_->assert_formula(solver_->make_term(
+      And, init0_, solver_->make_term(And, solver_trans, bad_i)));
+
+  Result r = solver_->check_sat();
+  if (!r.is_sat()) {
+    throw PonoException("Internal error: Expecting satisfiable result");
+  }
+  // increment reached_k_ so that witness goes up to the bad state
+  ++reached_k_;
+}
+
 bool InterpolantMC::step_0()
 {
   reset_assertions(solver_);
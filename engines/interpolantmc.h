@@ -45,6 +45,20 @@ class InterpolantMC : public Prover
   bool step(int i);
   bool step_0();
 
+  /** step with --interp-incremental
+   *  The A and B sides are kept as interpolator_ terms across
+   *  iterations, so only the new frame and the new interpolant are
+   *  translated. The fixpoint check only adds the negation of the new
+   *  interpolant to solver_ in each iteration.
+   */
+  bool step_incremental(int i);
+
+  /** Replays init0_ /\ transA_ /\ transB_ /\ bad_i in solver_
+   *  so that a witness can be computed
+   *  @param bad_i the bad states at bound i
+   */
+  void replay_cex(const smt::Term & bad_i);
+
   void reset_assertions(smt::SmtSolver & s);
 
   bool check_entail(const smt::Term & p, const smt::Term & q);
@@ -63,6 +77,14 @@ class InterpolantMC : public Prover
   smt::Term transB_;
   smt::Term bad_disjuncts_;  ///< a disjunction of bads in the suffix
 
+  // interpolator_ versions of the terms above (with --interp-incremental)
+  smt::Term int_init0_;
+  smt::Term int_transA_;
+  smt::Term int_transB_;
+  smt::Term int_bad_disjuncts_;
+  ///< maps the interpolator_ symbols at time 1 to time 0
+  smt::UnorderedTermMap int_to_time0_;
+
 };  // class InterpolantMC
 
 }  // namespace pono
@@ -0,0 +1,261 @@
+/*********************                                                        */
+/*! \file interpseqmc.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Makai Mann, Ahmed Irfan
+ ** This file is part of the pono project.
+ ** Copyright (c) 2026 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file LICENSE in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Interpolation-sequence based model checking.
+ **
+ **
+ **/
+
+#include "engines/interpseqmc.h"
+
+#include "smt-switch/exceptions.h"
+#include "smt-switch/utils.h"
+#include "utils/logger.h"
+
+using namespace smt;
+
+namespace pono {
+
+InterpSeqMC::InterpSeqMC(const Property & p,
+                         const TransitionSystem & ts,
+                         const SmtSolver & slv,
+                         const SmtSolver & itp,
+                         PonoOptions opt)
+    : super(p, ts, slv, opt),
+      interpolator_(itp),
+      to_interpolator_(interpolator_),
+      to_solver_(solver_),
+      concrete_cex_(false),
+      symbols_bound_(-1)
+{
+  engine_ = Engine::ISB;
+}
+
+InterpSeqMC::~InterpSeqMC() {}
+
+void InterpSeqMC::initialize()
+{
+  if (initialized_) {
+    return;
+  }
+
+  super::initialize();
+
+  // need to copy over UF as well
+  UnorderedTermMap & cache = to_solver_.get_cache();
+  UnorderedTermSet free_symbols;
+  get_free_symbols(bad_, free_symbols);
+  get_free_symbols(ts_.init(), free_symbols);
+  get_free_symbols(ts_.trans(), free_symbols);
+  for (const auto & s : free_symbols) {
+    if (s->get_sort()->get_sort_kind() == FUNCTION) {
+      cache[to_interpolator_.transfer_term(s)] = s;
+    }
+  }
+
+  concrete_cex_ = false;
+  fwd_ = { ts_.init() };
+  if (options_.isb_dual_) {
+    bwd_ = { bad_ };
+  }
+}
+
+ProverResult InterpSeqMC::check_until(int k)
+{
+  initialize();
+
+  try {
+    for (int i = 0; i <= k; ++i) {
+      if (step(i)) {
+        return ProverResult::TRUE;
+      } else if (concrete_cex_) {
+        compute_witness();
+        return ProverResult::FALSE;
+      }
+    }
+  }
+  catch (InternalSolverException & e) {
+    logger.log(1, "Failed when computing interpolants.");
+  }
+  return ProverResult::UNKNOWN;
+}
+
+bool InterpSeqMC::step(int i)
+{
+  if (i <= reached_k_) {
+    return false;
+  }
+
+  logger.log(1, "Checking interpolation sequence at bound: {}", i);
+
+  if (i == 0) {
+    // no interpolants at bound 0
+    return step_0();
+  }
+
+  register_symbol_mappings(i);
+
+  // Init_0, T_01 /\ F_1, ..., T_i-1i /\ F_i, Bad_i
+  TermVec formulae;
+  formulae.reserve(i + 2);
+  formulae.push_back(
+      to_interpolator_.transfer_term(unroller_.at_time(ts_.init(), 0), BOOL));
+  for (int j = 1; j <= i; ++j) {
+    Term t = unroller_.at_time(ts_.trans(), j - 1);
+    if (!options_.isb_dual_ && size_t(j) < fwd_.size()) {
+      // the forward frames over-approximate the reachable states, so
+      // they only prune the query. Not used with --isb-dual because the
+      // negated interpolants would then miss some predecessors
+      t = solver_->make_term(And, t, unroller_.at_time(fwd_[j], j));
+    }
+    formulae.push_back(to_interpolator_.transfer_term(t, BOOL));
+  }
+  formulae.push_back(
+      to_interpolator_.transfer_term(unroller_.at_time(bad_, i), BOOL));
+
+  TermVec out_interpolants;
+  Result r =
+      interpolator_->get_sequence_interpolants(formulae, out_interpolants);
+
+  if (r.is_sat()) {
+    replay_cex(i);
+    return false;
+  } else if (r.is_unknown()) {
+    throw PonoException("Interpolant generation failed.");
+  }
+  assert(out_interpolants.size() == size_t(i + 1));
+
+  Term true_ = solver_->make_term(true);
+  fwd_.resize(i + 1, true_);
+  if (options_.isb_dual_) {
+    bwd_.resize(i + 1, true_);
+  }
+
+  // out_interpolants[j] is over the symbols at time j
+  for (int j = 0; j <= i; ++j) {
+    Term I = unroller_.untime(
+        to_solver_.transfer_term(out_interpolants[j], BOOL));
+    if (j > 0) {
+      fwd_[j] = solver_->make_term(And, fwd_[j], I);
+    }
+    if (options_.isb_dual_ && j < i) {
+      // !I_j contains the states at time j that reach bad_i
+      bwd_[i - j] =
+          solver_->make_term(And, bwd_[i - j], solver_->make_term(Not, I));
+    }
+  }
+
+  int j = fixpoint(fwd_);
+  if (j > 0) {
+    logger.log(1, "Found a forward fixpoint at frame {} of bound {}", j, i);
+    invar_ = disjoin(fwd_, j);
+    return true;
+  }
+
+  if (options_.isb_dual_) {
+    int d = fixpoint(bwd_);
+    if (d > 0) {
+      logger.log(1, "Found a backward fixpoint at frame {} of bound {}", d, i);
+      invar_ = solver_->make_term(Not, disjoin(bwd_, d));
+      return true;
+    }
+  }
+
+  ++reached_k_;
+  return false;
+}
+
+bool InterpSeqMC::step_0()
+{
+  solver_->push();
+  solver_->assert_formula(unroller_.at_time(ts_.init(), 0));
+  solver_->assert_formula(unroller_.at_time(bad_, 0));
+
+  Result r = solver_->check_sat();
+  if (r.is_unsat()) {
+    solver_->pop();
+    ++reached_k_;
+  } else {
+    // keep the model for the witness
+    concrete_cex_ = true;
+  }
+  return false;
+}
+
+void InterpSeqMC::register_symbol_mappings(int i)
+{
+  UnorderedTermMap & cache = to_solver_.get_cache();
+  Term unrolled;
+  while (symbols_bound_ < i) {
+    ++symbols_bound_;
+    for (const auto & sv : ts_.statevars()) {
+      unrolled = unroller_.at_time(sv, symbols_bound_);
+      cache[to_interpolator_.transfer_term(unrolled)] = unrolled;
+    }
+    for (const auto & iv : ts_.inputvars()) {
+      unrolled = unroller_.at_time(iv, symbols_bound_);
+      cache[to_interpolator_.transfer_term(unrolled)] = unrolled;
+    }
+  }
+}
+
+int InterpSeqMC::fixpoint(const TermVec & frames)
+{
+  // !frames[0] /\ ... /\ !frames[j-1] is kept asserted
+  // so each frame is only checked against it once
+  int res = -1;
+  solver_->push();
+  solver_->assert_formula(solver_->make_term(Not, frames[0]));
+  for (size_t j = 1; j < frames.size(); ++j) {
+    solver_->push();
+    solver_->assert_formula(frames[j]);
+    Result r = solver_->check_sat();
+    solver_->pop();
+    assert(r.is_unsat() || r.is_sat());
+    if (r.is_unsat()) {
+      res = j;
+      break;
+    }
+    solver_->assert_formula(solver_->make_term(Not, frames[j]));
+  }
+  solver_->pop();
+  return res;
+}
+
+Term InterpSeqMC::disjoin(const TermVec & frames, int j)
+{
+  Term res = frames[0];
+  for (int i = 1; i < j; ++i) {
+    res = solver_->make_term(Or, res, frames[i]);
+  }
+  return res;
+}
+
+void InterpSeqMC::replay_cex(int i)
+{
+  // found a concrete counter example
+  // replay it in the solver with model generation
+  concrete_cex_ = true;
+  solver_->assert_formula(unroller_.at_time(ts_.init(), 0));
+  for (int j = 0; j < i; ++j) {
+    solver_->assert_formula(unroller_.at_time(ts_.trans(), j));
+  }
+  solver_->assert_formula(unroller_.at_time(bad_, i));
+
+  Result r = solver_->check_sat();
+  if (!r.is_sat()) {
+    throw PonoException("Internal error: Expecting satisfiable result");
+  }
+  // increment reached_k_ so that witness goes up to the bad state
+  ++reached_k_;
+}
+
+}  // namespace pono
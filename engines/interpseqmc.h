@@ -0,0 +1,90 @@
+/*********************                                                        */
+/*! \file interpseqmc.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Makai Mann, Ahmed Irfan
+ ** This file is part of the pono project.
+ ** Copyright (c) 2026 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved.  See the file LICENSE in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Interpolation-sequence based model checking.
+ **        See Interpolation-sequence based model checking
+ **        (Vizel and Grumberg) and, with --isb-dual, DAR: SAT-based
+ **        Dual Approximated Reachability (Vizel, Grumberg and Shoham).
+ **
+ **        At bound k, the sequence interpolants of
+ **          Init_0, T_01, ..., T_k-1k, Bad_k
+ **        strengthen the forward frames F_1..F_k, where F_j
+ **        over-approximates the states reachable in exactly j steps.
+ **        The frames are kept across bounds. With --isb-dual, the
+ **        negated interpolants also strengthen backward frames B_1..B_k,
+ **        where B_d over-approximates the states that reach bad in
+ **        exactly d steps.
+ **
+ **/
+
+#pragma once
+
+#include "engines/prover.h"
+
+#include "smt-switch/smt.h"
+
+namespace pono {
+
+class InterpSeqMC : public Prover
+{
+ public:
+  InterpSeqMC(const Property & p,
+              const TransitionSystem & ts,
+              const smt::SmtSolver & slv,
+              const smt::SmtSolver & itp,
+              PonoOptions opt = PonoOptions());
+
+  ~InterpSeqMC();
+
+  typedef Prover super;
+
+  void initialize() override;
+
+  ProverResult check_until(int k) override;
+
+ protected:
+  bool step(int i);
+  bool step_0();
+
+  /** Adds the interpolator_ symbols up to time i to the to_solver_ cache */
+  void register_symbol_mappings(int i);
+
+  /** Finds a fixpoint in a sequence of frames
+   *  @param frames untimed frames, frames[0] is the initial (or bad) set
+   *  @return the first j > 0 such that
+   *          frames[j] |= frames[0] \/ ... \/ frames[j-1], or -1
+   */
+  int fixpoint(const smt::TermVec & frames);
+
+  /** @return frames[0] \/ ... \/ frames[j-1] */
+  smt::Term disjoin(const smt::TermVec & frames, int j);
+
+  /** Replays the counterexample of length i in solver_
+   *  so that a witness can be computed
+   */
+  void replay_cex(int i);
+
+  smt::SmtSolver interpolator_;
+  // for translating terms to interpolator_
+  smt::TermTranslator to_interpolator_;
+  // for translating terms to solver_
+  smt::TermTranslator to_solver_;
+
+  // set to true when a concrete_cex is found
+  bool concrete_cex_;
+
+  smt::TermVec fwd_;  ///< forward frames, fwd_[0] is init
+  smt::TermVec bwd_;  ///< backward frames (with --isb-dual), bwd_[0] is bad
+  int symbols_bound_;  ///< symbols are registered up to this time
+
+};  // class InterpSeqMC
+
+}  // namespace pono
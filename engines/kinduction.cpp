@@ -15,6 +15,13 @@
  **/
 
 #include "kinduction.h"
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+
+#include "smt/available_solvers.h"
+#include "utils/invariant_miner.h"
 #include "utils/logger.h"
 
 using namespace smt;
@@ -24,7 +31,12 @@ namespace pono {
 KInduction::KInduction(const Property & p, const TransitionSystem & ts,
                        const SmtSolver & solver,
                        PonoOptions opt)
-  : super(p, ts, solver, opt)
+  : super(p, ts, solver, opt),
+    simple_path_enc_(ts_, unroller_, solver_),
+    lemmas_bound_(-1),
+    mine_at_(-1),
+    num_mining_rounds_(0),
+    step_proved_at_(-1)
 {
   engine_ = Engine::KIND;
 }
@@ -45,15 +57,40 @@ void KInduction::initialize()
   // future we can use solver_->reset_assertions(), but it is not currently
   // supported in boolector
   init0_ = unroller_.at_time(ts_.init(), 0);
-  false_ = solver_->make_term(false);
   simple_path_ = solver_->make_term(true);
+
+  if (options_.activation_lits_) {
+    init_lit_ = make_activation_lit("kind_init");
+    solver_->assert_formula(solver_->make_term(Implies, init_lit_, init0_));
+  }
+
+  // with two solvers, only the inductive step needs the invariants
+  // they are asserted at every time step like the imported lemmas
+  if (options_.kind_mine_invariants_ && !options_.kind_dual_solver_) {
+    mine_at_ = 0;
+  }
+
+  if (options_.kind_dual_solver_) {
+    // created here, on the main thread, like the workers of a portfolio
+    PonoOptions opts = options_;
+    opts.kind_dual_solver_ = false;
+    SmtSolver step_solver = create_solver(solver_->get_solver_enum());
+    step_prover_ = std::make_shared<KInduction>(
+        orig_property_, orig_ts_, step_solver, opts);
+    step_prover_->initialize();
+  }
 }
 
 ProverResult KInduction::check_until(int k)
 {
   initialize();
 
+  if (step_prover_) {
+    return check_until_dual(k);
+  }
+
   for (int i = 0; i <= k; ++i) {
+    import_lemmas(i);
     logger.log(1, "Checking k-induction base case at bound: {}", i);
     if (!base_step(i)) {
       compute_witness();
@@ -73,21 +110,112 @@ bool KInduction::base_step(int i)
     return true;
   }
 
-  solver_->push();
-  solver_->assert_formula(init0_);
-  solver_->assert_formula(unroller_.at_time(bad_, i));
-  Result r = solver_->check_sat();
-  if (r.is_sat()) {
-    ++reached_k_;
-    return false;
+  if (options_.activation_lits_) {
+    Term act = make_activation_lit("kind_bad");
+    solver_->assert_formula(
+        solver_->make_term(Implies, act, unroller_.at_time(bad_, i)));
+    Result r = solver_->check_sat_assuming({ init_lit_, act });
+    if (r.is_sat()) {
+      ++reached_k_;
+      return false;
+    }
+    solver_->assert_formula(solver_->make_term(Not, act));
+  } else {
+    solver_->push();
+    solver_->assert_formula(init0_);
+    solver_->assert_formula(unroller_.at_time(bad_, i));
+    Result r = solver_->check_sat();
+    if (r.is_sat()) {
+      ++reached_k_;
+      return false;
+    }
+    solver_->pop();
   }
-  solver_->pop();
 
+  extend_unrolling(i);
+
+  return true;
+}
+
+void KInduction::extend_unrolling(int i)
+{
   const Term &prop = solver_->make_term(Not, bad_);
   solver_->assert_formula(unroller_.at_time(ts_.trans(), i));
   solver_->assert_formula(unroller_.at_time(prop, i));
+}
 
-  return true;
+ProverResult KInduction::check_until_dual(int k)
+{
+  if (step_proved_at_ >= 0 && step_proved_at_ <= reached_k_) {
+    return ProverResult::TRUE;
+  }
+
+  // the step prover only touches its own solver
+  // exceptions are passed to this thread, they can't leave step_thread
+  std::atomic<bool> cancel(false);
+  std::atomic<bool> step_failed(false);
+  std::exception_ptr step_error;
+  std::thread step_thread([this, k, &cancel, &step_failed, &step_error]() {
+    try {
+      KInduction & sp = *step_prover_;
+      for (int i = sp.reached_k_ + 1;
+           i <= k && step_proved_at_ < 0 && !cancel;
+           ++i) {
+        logger.log(1, "Checking k-induction inductive step at bound: {}", i);
+        sp.import_lemmas(i);
+        sp.extend_unrolling(i);
+        if (sp.inductive_step(i)) {
+          step_proved_at_ = i;
+        }
+      }
+    }
+    catch (...) {
+      step_error = std::current_exception();
+      step_failed = true;
+    }
+  });
+
+  ProverResult res = ProverResult::UNKNOWN;
+  std::exception_ptr base_error;
+  try {
+    for (int i = reached_k_ + 1; i <= k && !step_failed; ++i) {
+      int j = step_proved_at_;
+      if (j >= 0 && j <= reached_k_) {
+        break;
+      }
+      logger.log(1, "Checking k-induction base case at bound: {}", i);
+      if (!base_step(i)) {
+        res = ProverResult::FALSE;
+        break;
+      }
+      // the inductive step doesn't advance reached_k_ on this solver
+      reached_k_ = i;
+    }
+  }
+  catch (...) {
+    base_error = std::current_exception();
+  }
+
+  // the step thread can only be stopped between bounds
+  cancel = (res == ProverResult::FALSE || base_error);
+  step_thread.join();
+  if (base_error) {
+    std::rethrow_exception(base_error);
+  } else if (step_error) {
+    std::rethrow_exception(step_error);
+  }
+
+  if (res == ProverResult::FALSE) {
+    compute_witness();
+  } else if (step_proved_at_ >= 0 && step_proved_at_ <= reached_k_) {
+    logger.log(1,
+               "Inductive step succeeded at bound {}, base case checked up "
+               "to bound {}",
+               int(step_proved_at_),
+               reached_k_);
+    res = ProverResult::TRUE;
+  }
+  return res;
 }
 
 bool KInduction::inductive_step(int i)
@@ -96,66 +224,161 @@ bool KInduction::inductive_step(int i)
     return false;
   }
 
-  solver_->push();
-  solver_->assert_formula(simple_path_);
-  solver_->assert_formula(unroller_.at_time(bad_, i + 1));
+  if (options_.activation_lits_) {
+    // simple path constraints are added at the base context
+    // this is sound for the base case too: the bad states were not
+    // reachable in fewer steps, so any counterexample of the current
+    // length is a shortest one and thus a simple path
+    Term act = make_activation_lit("kind_step_bad");
+    solver_->assert_formula(
+        solver_->make_term(Implies, act, unroller_.at_time(bad_, i + 1)));
+    if (ts_.statevars().size() && check_simple_path_lazy(i + 1, { act })) {
+      return true;
+    }
+    solver_->assert_formula(solver_->make_term(Not, act));
+  } else {
+    solver_->push();
+    solver_->assert_formula(simple_path_);
+    solver_->assert_formula(unroller_.at_time(bad_, i + 1));
 
-  if (ts_.statevars().size() && check_simple_path_lazy(i + 1)) {
-    return true;
-  }
+    if (ts_.statevars().size() && check_simple_path_lazy(i + 1)) {
+      return true;
+    }
 
-  solver_->pop();
+    solver_->pop();
+  }
 
   ++reached_k_;
 
   return false;
 }
 
-Term KInduction::simple_path_constraint(int i, int j)
+bool KInduction::check_simple_path_lazy(int i, const TermVec & assumps)
 {
-  assert(ts_.statevars().size());
+  while (true) {
+    Result r = assumps.size() ? solver_->check_sat_assuming(assumps)
+                              : solver_->check_sat();
+    if (r.is_unsat()) {
+      return true;
+    }
 
-  Term disj = false_;
-  for (const auto &v : ts_.statevars()) {
-    Term vi = unroller_.at_time(v, i);
-    Term vj = unroller_.at_time(v, j);
-    Term eq = solver_->make_term(PrimOp::Equal, vi, vj);
-    Term neq = solver_->make_term(PrimOp::Not, eq);
-    disj = solver_->make_term(PrimOp::Or, disj, neq);
-  }
+    TermVec constraints = simple_path_enc_.violated(i);
+    if (constraints.empty()) {
+      return false;
+    }
 
-  return disj;
+    logger.log(2, "Adding {} Simple Path Clauses", constraints.size());
+    for (const auto & c : constraints) {
+      simple_path_ = solver_->make_term(PrimOp::And, simple_path_, c);
+      solver_->assert_formula(c);
+    }
+  }
 }
 
-bool KInduction::check_simple_path_lazy(int i)
+void KInduction::import_lemmas(int i)
 {
-  bool added_to_simple_path = false;
+  if (!lemma_bus_ && lemmas_.empty() && mine_at_ < 0) {
+    return;
+  }
 
-  do {
-    Result r = solver_->check_sat();
-    if (r.is_unsat()) {
-      return true;
+  size_t num_old = lemmas_.size();
+  if (mine_at_ >= 0 && i >= mine_at_) {
+    mine_invariants(i);
+  }
+  if (lemma_bus_) {
+    for (const auto & l : fetch_lemmas()) {
+      if (check_lemma(l)) {
+        lemmas_.push_back(l);
+      }
     }
+  }
 
-    added_to_simple_path = false;
+  if (lemmas_.size() > num_old) {
+    logger.log(1,
+               "KInduction: imported {} lemmas",
+               lemmas_.size() - num_old);
+  }
 
-    for (int j = 0; j < i && !added_to_simple_path; ++j) {
-      for (int l = j + 1; l <= i; ++l) {
-        Term constraint = simple_path_constraint(j, l);
-        if (solver_->get_value(constraint) == false_) {
-	  logger.log(2, "Adding Simple Path Clause");
-          simple_path_ =
-              solver_->make_term(PrimOp::And, simple_path_, constraint);
-          solver_->assert_formula(constraint);
-          added_to_simple_path = true;
-          break;
-        }
-      }
+  // the accepted lemmas are invariants, so they can be
+  // asserted at every time step at the base context
+  for (size_t j = num_old; j < lemmas_.size(); ++j) {
+    for (int t = 0; t <= lemmas_bound_; ++t) {
+      solver_->assert_formula(unroller_.at_time(lemmas_[j], t));
+    }
+  }
+
+  while (lemmas_bound_ < i + 1) {
+    ++lemmas_bound_;
+    for (const auto & l : lemmas_) {
+      solver_->assert_formula(unroller_.at_time(l, lemmas_bound_));
+    }
+  }
+}
+
+void KInduction::mine_invariants(int i)
+{
+  // twice as long simulation runs each round, up to 1024 cycles
+  unsigned int cycles = 64u << std::min(num_mining_rounds_, 4u);
+  InvariantMiner miner(
+      ts_, 4, cycles, options_.random_seed_ + num_mining_rounds_);
+  num_mining_rounds_++;
+
+  // each round proves an inductive set of invariants
+  // so the conjunction with the accepted lemmas stays inductive
+  UnorderedTermSet known(lemmas_.begin(), lemmas_.end());
+  size_t num_new = 0;
+  for (const auto & inv : miner.mine()) {
+    if (known.insert(inv).second) {
+      lemmas_.push_back(inv);
+      num_new++;
     }
+  }
+  logger.log(1,
+             "KInduction: mined {} new invariants at bound {}",
+             num_new,
+             i);
 
-  } while (added_to_simple_path);
+  mine_at_ = std::max<int64_t>(8, 2 * int64_t(i));
+}
 
-  return false;
+bool KInduction::check_lemma(const Term & l)
+{
+  if (!ts_.only_curr(l)) {
+    return false;
+  }
+
+  if (!lemma_solver_) {
+    lemma_solver_ = create_solver(solver_->get_solver_enum());
+    to_lemma_solver_.reset(new TermTranslator(lemma_solver_));
+    lemma_init_ = to_lemma_solver_->transfer_term(ts_.init(), BOOL);
+    lemma_solver_->assert_formula(
+        to_lemma_solver_->transfer_term(ts_.trans(), BOOL));
+  }
+
+  Term lemma = to_lemma_solver_->transfer_term(l, BOOL);
+  Term next_lemma = to_lemma_solver_->transfer_term(ts_.next(l), BOOL);
+
+  lemma_solver_->push();
+  lemma_solver_->assert_formula(lemma_init_);
+  lemma_solver_->assert_formula(lemma_solver_->make_term(Not, lemma));
+  Result r = lemma_solver_->check_sat();
+  lemma_solver_->pop();
+  if (!r.is_unsat()) {
+    return false;
+  }
+
+  lemma_solver_->push();
+  lemma_solver_->assert_formula(lemma);
+  lemma_solver_->assert_formula(lemma_solver_->make_term(Not, next_lemma));
+  r = lemma_solver_->check_sat();
+  lemma_solver_->pop();
+  if (!r.is_unsat()) {
+    return false;
+  }
+
+  // later lemmas only need to be inductive relative to this one
+  lemma_solver_->assert_formula(lemma);
+  return true;
 }
 
 }  // namespace pono
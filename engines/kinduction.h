@@ -16,7 +16,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "core/simple_path.h"
 #include "engines/prover.h"
+#include "smt-switch/term_translator.h"
 
 namespace pono {
 
@@ -39,12 +45,72 @@ class KInduction : public Prover
   bool base_step(int i);
   bool inductive_step(int i);
 
-  smt::Term simple_path_constraint(int i, int j);
-  bool check_simple_path_lazy(int i);
+  /** Asserts trans and the property at time i
+   *  (after the base case at bound i succeeded)
+   */
+  void extend_unrolling(int i);
+
+  /** check_until with --kind-dual-solver
+   *  The base case runs on solver_ on this thread and the inductive
+   *  step on step_prover_ (with its own solver) on another thread.
+   *  Returns TRUE once the step succeeded at some bound j and the
+   *  base case is clean up to j.
+   */
+  ProverResult check_until_dual(int k);
+
+  /** Checks the current solver context, lazily adding simple path
+   *  constraints between times 0..i until it is unsat or the
+   *  model is a simple path
+   *  @param i the last time step
+   *  @param assumps assumptions for the check (e.g. activation literals)
+   *  @return true iff the context is unsat
+   */
+  bool check_simple_path_lazy(int i, const smt::TermVec & assumps = {});
+
+  /** Imports lemmas from the lemma bus (if any), mines invariants
+   *  (with --kind-mine-invariants, see mine_invariants)
+   *  and asserts all accepted lemmas at times 0 through i+1
+   *  Lemmas are only accepted if they are inductive
+   *  relative to the previously accepted lemmas
+   *  i.e. the accepted lemmas are always an inductive invariant
+   *  @param i the current bound
+   */
+  void import_lemmas(int i);
+
+  /** Adds the invariants found by an InvariantMiner to lemmas_
+   *  Runs at bound 0 and again whenever the bound doubles (from 8 on),
+   *  each time with longer simulation runs and new stimuli. States that
+   *  earlier runs missed change the candidates (e.g. weaker bounds),
+   *  so later rounds can prove invariants the earlier ones could not
+   *  @param i the current bound
+   */
+  void mine_invariants(int i);
+
+  /** Checks that a lemma holds initially and is inductive relative
+   *  to the already accepted lemmas using a separate solver
+   *  @param l the lemma over current state variables
+   *  @return true iff the lemma was accepted
+   */
+  bool check_lemma(const smt::Term & l);
 
   smt::Term init0_;
-  smt::Term false_;
-  smt::Term simple_path_;
+  smt::Term init_lit_;  ///< init_lit_ -> init0_ (with --activation-lits)
+  smt::Term simple_path_;  ///< simple path constraints added so far
+  SimplePathEncoder simple_path_enc_;
+
+  smt::TermVec lemmas_;  ///< accepted lemmas and mined invariants
+                         ///< (together inductive)
+  int lemmas_bound_;  ///< all lemmas are asserted at times 0..lemmas_bound_
+  smt::SmtSolver lemma_solver_;  ///< solver for checking imported lemmas
+  std::unique_ptr<smt::TermTranslator> to_lemma_solver_;
+  smt::Term lemma_init_;  ///< init in lemma_solver_
+  int64_t mine_at_;  ///< bound of the next mining round, -1 if disabled
+  unsigned int num_mining_rounds_;
+
+  ///< runs the inductive steps with --kind-dual-solver (its own solver)
+  std::shared_ptr<KInduction> step_prover_;
+  ///< first bound at which step_prover_ succeeded, or -1
+  std::atomic<int> step_proved_at_;
 
 };  // class KInduction
 
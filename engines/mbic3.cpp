@@ -204,6 +204,7 @@ vector<IC3Formula> ModelBasedIC3::inductive_generalization(size_t i,
             if (r.is_sat()) {
               // we cannot drop a
               pop_solver_context();
+              release_labels(tmp);
             } else {
               new_tmp.clear();
               removed.clear();
@@ -219,6 +220,7 @@ vector<IC3Formula> ModelBasedIC3::inductive_generalization(size_t i,
               }
 
               pop_solver_context();
+              release_labels(tmp);
 
               // keep in mind that you cannot drop a literal if it causes c to
               // intersect with the initial states
@@ -357,7 +359,28 @@ IC3Formula ModelBasedIC3::generalize_predecessor(size_t i, const IC3Formula & c)
     return res;
   }
 
-  if (options_.ic3_pregen_ && !options_.ic3_functional_preimage_) {
+  TermVec vars(statevars.begin(), statevars.end()), lifted;
+  if (pregen_round_) {
+    // another predecessor from the same model, try another order
+    shuffle(vars.begin(),
+            vars.end(),
+            default_random_engine(options_.random_seed_ + pregen_round_));
+  }
+  if (options_.ic3_pregen_ && options_.ic3_ternary_sim_
+      && ternary_lift(c, vars, lifted)) {
+    // cube_lits are still v = val in the order of statevars
+    UnorderedTermSet keep(lifted.begin(), lifted.end());
+    TermVec red_cube_lits;
+    size_t j = 0;
+    for (const auto &v : statevars) {
+      if (keep.find(v) != keep.end()) {
+        red_cube_lits.push_back(cube_lits[j]);
+      }
+      ++j;
+    }
+    res = ic3formula_conjunction(red_cube_lits);
+
+  } else if (options_.ic3_pregen_ && !options_.ic3_functional_preimage_) {
     // add congruent equalities to cube_lits
     for (const auto &v : statevars) {
       Term t = ds.find(v);
@@ -401,7 +424,7 @@ IC3Formula ModelBasedIC3::generalize_predecessor(size_t i, const IC3Formula & c)
     reducer_.reduce_assump_unsatcore(formula, splits, red_cube_lits,
                                      &rem_cube_lits,
                                      options_.ic3_gen_max_iter_,
-                                     options_.random_seed_);
+                                     options_.random_seed_ + pregen_round_);
     // should need some assumptions
     // formula should not be unsat on its own
     assert(red_cube_lits.size() > 0);
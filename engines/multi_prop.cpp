@@ -0,0 +1,222 @@
+/*********************                                                        */
+/*! \file multi_prop.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Checks several properties of the same transition system in
+**        one bmc or k-induction session.
+**
+**
+**/
+
+#include "engines/multi_prop.h"
+
+#include <cassert>
+
+#include "utils/exceptions.h"
+#include "utils/logger.h"
+
+using namespace smt;
+using namespace std;
+
+namespace pono {
+
+MultiPropProver::MultiPropProver(const vector<Property> & props,
+                                 const TransitionSystem & ts,
+                                 const SmtSolver & solver,
+                                 PonoOptions opt)
+    : super(props.at(0), ts, solver, opt),
+      orig_props_(props),
+      simple_path_enc_(ts_, unroller_, solver_),
+      num_trans_(0)
+{
+  engine_ = options_.engine_;
+}
+
+MultiPropProver::~MultiPropProver() {}
+
+void MultiPropProver::initialize()
+{
+  if (initialized_) {
+    return;
+  }
+
+  super::initialize();
+
+  if (engine_ != BMC && engine_ != KIND) {
+    throw PonoException(
+        "Multi-property checking only supports the bmc and ind engines");
+  }
+
+  for (const auto & p : orig_props_) {
+    Term prop = (ts_.solver() == p.solver())
+                    ? p.prop()
+                    : to_prover_solver_.transfer_term(p.prop(), BOOL);
+    if (!ts_.only_curr(prop)) {
+      throw PonoException(
+          "Property should not contain inputs or next state variables");
+    }
+    bads_.push_back(solver_->make_term(Not, prop));
+    if (engine_ == KIND) {
+      prop_labels_.push_back(make_activation_lit("multi_prop_prop"));
+    }
+  }
+
+  results_.assign(orig_props_.size(), ProverResult::UNKNOWN);
+  decided_at_.assign(orig_props_.size(), -1);
+  witnesses_.resize(orig_props_.size());
+
+  // init is guarded so that the same unrolling
+  // can be used for the inductive step
+  init_label_ = make_activation_lit("multi_prop_init");
+  solver_->assert_formula(solver_->make_term(
+      Implies, init_label_, unroller_.at_time(ts_.init(), 0)));
+  simple_path_ = solver_->make_term(true);
+}
+
+ProverResult MultiPropProver::check_until(int k)
+{
+  initialize();
+
+  auto is_open = [this](size_t p) {
+    return results_[p] == ProverResult::UNKNOWN;
+  };
+
+  for (int i = reached_k_ + 1; i <= k; ++i) {
+    size_t num_open = 0;
+    for (size_t p = 0; p < results_.size(); ++p) {
+      num_open += is_open(p);
+    }
+    if (!num_open) {
+      break;
+    }
+    logger.log(1, "Checking {} open properties at bound: {}", num_open, i);
+    step(i);
+  }
+
+  bool all_true = true;
+  for (auto r : results_) {
+    if (r == ProverResult::FALSE) {
+      return ProverResult::FALSE;
+    }
+    all_true &= (r == ProverResult::TRUE);
+  }
+  return all_true ? ProverResult::TRUE : ProverResult::UNKNOWN;
+}
+
+bool MultiPropProver::witness(size_t i, vector<UnorderedTermMap> & out)
+{
+  if (results_.at(i) != ProverResult::FALSE) {
+    throw PonoException("No witness for property " + std::to_string(i)
+                        + " -- it was not falsified");
+  }
+  // reuse the default translation to the original system
+  witness_.swap(witnesses_[i]);
+  bool success = super::witness(out);
+  witness_.swap(witnesses_[i]);
+  return success;
+}
+
+void MultiPropProver::step(int i)
+{
+  assert(i == reached_k_ + 1);
+  unroll_to(i);
+
+  // base case (bmc)
+  for (size_t p = 0; p < bads_.size(); ++p) {
+    if (results_[p] != ProverResult::UNKNOWN) {
+      continue;
+    }
+
+    Term lbl = make_activation_lit("multi_prop_bad");
+    solver_->assert_formula(
+        solver_->make_term(Implies, lbl, unroller_.at_time(bads_[p], i)));
+    Result r = solver_->check_sat_assuming({ init_label_, lbl });
+    if (r.is_sat()) {
+      logger.log(1, "Property {} is false at bound {}", p, i);
+      results_[p] = ProverResult::FALSE;
+      decided_at_[p] = i;
+      reached_k_ = i;
+      compute_witness();
+      witness_.swap(witnesses_[p]);
+      witness_.clear();
+      reached_k_ = i - 1;
+    }
+    // retire the label
+    solver_->assert_formula(solver_->make_term(Not, lbl));
+  }
+
+  if (engine_ == KIND) {
+    unroll_to(i + 1);
+    for (size_t p = 0; p < bads_.size(); ++p) {
+      if (results_[p] != ProverResult::UNKNOWN) {
+        continue;
+      }
+
+      Term prop_i = unroller_.at_time(solver_->make_term(Not, bads_[p]), i);
+      solver_->assert_formula(
+          solver_->make_term(Implies, prop_labels_[p], prop_i));
+      if (inductive_step(p, i)) {
+        logger.log(1, "Property {} is true at bound {}", p, i);
+        results_[p] = ProverResult::TRUE;
+        decided_at_[p] = i;
+      }
+    }
+  }
+
+  reached_k_ = i;
+}
+
+void MultiPropProver::unroll_to(int n)
+{
+  while (num_trans_ < n) {
+    solver_->assert_formula(unroller_.at_time(ts_.trans(), num_trans_));
+    ++num_trans_;
+  }
+}
+
+bool MultiPropProver::inductive_step(size_t p, int i)
+{
+  if (!ts_.statevars().size()) {
+    // no simple path constraints possible
+    solver_->push();
+    solver_->assert_formula(unroller_.at_time(bads_[p], i + 1));
+    Result r = solver_->check_sat_assuming({ prop_labels_[p] });
+    solver_->pop();
+    return r.is_unsat();
+  }
+
+  solver_->push();
+  solver_->assert_formula(simple_path_);
+  solver_->assert_formula(unroller_.at_time(bads_[p], i + 1));
+
+  bool proved = false;
+  while (true) {
+    Result r = solver_->check_sat_assuming({ prop_labels_[p] });
+    if (r.is_unsat()) {
+      proved = true;
+      break;
+    }
+
+    TermVec constraints = simple_path_enc_.violated(i + 1);
+    if (constraints.empty()) {
+      break;
+    }
+    logger.log(2, "Adding {} Simple Path Clauses", constraints.size());
+    for (const auto & c : constraints) {
+      simple_path_ = solver_->make_term(PrimOp::And, simple_path_, c);
+      solver_->assert_formula(c);
+    }
+  }
+
+  solver_->pop();
+  return proved;
+}
+
+}  // namespace pono
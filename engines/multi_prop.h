@@ -0,0 +1,99 @@
+/*********************                                                        */
+/*! \file multi_prop.h
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Checks several properties of the same transition system in
+**        one bmc or k-induction session.
+**
+**        The transition relation is unrolled once per bound and each
+**        property that is still open is queried under its own
+**        assumption literal. Properties drop out once they are decided.
+**
+**/
+
+#pragma once
+
+#include "core/simple_path.h"
+#include "engines/prover.h"
+
+namespace pono {
+
+class MultiPropProver : public Prover
+{
+ public:
+  /** Constructor
+   *  @param props the properties to check (non-empty)
+   *  @param ts the transition system
+   *  @param solver the solver to use
+   *  @param opt options -- engine_ must be BMC or KIND
+   */
+  MultiPropProver(const std::vector<Property> & props,
+                  const TransitionSystem & ts,
+                  const smt::SmtSolver & solver,
+                  PonoOptions opt = PonoOptions());
+
+  ~MultiPropProver();
+
+  typedef Prover super;
+
+  void initialize() override;
+
+  /** Checks all open properties up to bound k
+   *  @return FALSE if any property is FALSE, TRUE if all properties are
+   *          TRUE and UNKNOWN otherwise
+   */
+  ProverResult check_until(int k) override;
+
+  /** @return the number of properties */
+  size_t num_props() const { return orig_props_.size(); }
+
+  /** @return the result for the i-th property */
+  ProverResult result(size_t i) const { return results_.at(i); }
+
+  /** @return the bound at which the i-th property was decided
+   *          or -1 if it is still open
+   */
+  int decided_at(size_t i) const { return decided_at_.at(i); }
+
+  /** Get the witness for the i-th property
+   *  @requires result(i) == FALSE
+   *  @param i the property index
+   *  @param out the vector to populate
+   *  @return true if the witness is complete
+   */
+  bool witness(size_t i, std::vector<smt::UnorderedTermMap> & out);
+
+ protected:
+  /** Checks all open properties at bound i */
+  void step(int i);
+
+  /** Makes sure trans is unrolled for times 0 through n-1 */
+  void unroll_to(int n);
+
+  /** Inductive step for property p at bound i
+   *  @return true iff bad_p can't be reached in i+1 steps from
+   *          a simple path where p holds at times 0..i
+   */
+  bool inductive_step(size_t p, int i);
+
+  std::vector<Property> orig_props_;
+  smt::TermVec bads_;  ///< negated properties in the prover's solver
+  smt::TermVec prop_labels_;  ///< prop_labels_[p] -> !bads_[p] at all times
+  std::vector<ProverResult> results_;
+  std::vector<int> decided_at_;
+  std::vector<std::vector<smt::UnorderedTermMap>> witnesses_;
+
+  smt::Term init_label_;  ///< init_label_ -> init@0
+  smt::Term simple_path_;
+  SimplePathEncoder simple_path_enc_;
+  int num_trans_;  ///< number of unrolled trans asserted
+};
+
+}  // namespace pono
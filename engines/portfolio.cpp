@@ -0,0 +1,217 @@
+/*********************                                                        */
+/*! \file portfolio.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief In-process portfolio that races several engines on threads.
+**
+**
+**/
+
+#include "engines/portfolio.h"
+
+#include <cassert>
+#include <thread>
+
+#include "smt/available_solvers.h"
+#include "utils/exceptions.h"
+#include "utils/logger.h"
+#include "utils/make_provers.h"
+
+using namespace smt;
+using namespace std;
+
+namespace pono {
+
+static string engine_name(Engine e)
+{
+  for (const auto & elem : str2engine) {
+    if (elem.second == e) {
+      return elem.first;
+    }
+  }
+  return std::to_string(e);
+}
+
+Portfolio::Portfolio(const Property & p,
+                     const TransitionSystem & ts,
+                     const SmtSolver & solver,
+                     PonoOptions opt)
+    : super(p, ts, solver, opt), cancel_(false), winner_idx_(-1)
+{
+  engine_ = Engine::PORTFOLIO;
+}
+
+Portfolio::~Portfolio() {}
+
+void Portfolio::initialize()
+{
+  if (initialized_) {
+    return;
+  }
+
+  super::initialize();
+
+  if (options_.portfolio_share_lemmas_) {
+    bus_ = make_shared<LemmaBus>();
+  }
+
+  // all workers are created and initialized here, on the main thread
+  // after this point, each worker only touches its own solver
+  for (const auto & e : options_.portfolio_engines_) {
+    if (e == Engine::PORTFOLIO) {
+      throw PonoException("Portfolio cannot contain itself");
+    } else if (e == Engine::MSAT_IC3IA) {
+      // only supports prove, so it would block the portfolio
+      // until it finishes even when another engine won
+      throw PonoException("Portfolio cannot contain msat-ic3ia");
+    }
+
+    try {
+      shared_ptr<Prover> w = make_worker(e);
+      engines_.push_back(e);
+      workers_.push_back(w);
+      results_.push_back(ProverResult::UNKNOWN);
+    }
+    catch (std::exception & ex) {
+      logger.log(1,
+                 "Portfolio: skipping engine {} -- {}",
+                 engine_name(e),
+                 ex.what());
+    }
+  }
+
+  if (workers_.empty()) {
+    throw PonoException("Portfolio could not create any engine");
+  }
+}
+
+ProverResult Portfolio::check_until(int k)
+{
+  initialize();
+
+  if (winner_idx_ >= 0) {
+    return results_[winner_idx_];
+  }
+
+  cancel_ = false;
+
+  logger.log(1, "Portfolio: racing {} engines", workers_.size());
+  vector<thread> threads;
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    threads.push_back(thread(&Portfolio::run_worker, this, i, k));
+  }
+
+  for (auto & t : threads) {
+    t.join();
+  }
+
+  if (bus_) {
+    logger.log(1, "Portfolio: {} lemmas were shared", bus_->size());
+  }
+
+  if (winner_idx_ < 0) {
+    reached_k_ = k;
+    return ProverResult::UNKNOWN;
+  }
+
+  ProverResult res = results_[winner_idx_];
+  logger.log(1,
+             "Portfolio: engine {} returned {}",
+             engine_name(engines_[winner_idx_]),
+             to_string(res));
+
+  if (res == ProverResult::TRUE) {
+    try {
+      invar_ = to_prover_solver_.transfer_term(workers_[winner_idx_]->invar(),
+                                               BOOL);
+    }
+    catch (PonoException & e) {
+      // winning engine does not support invariants
+    }
+  }
+
+  return res;
+}
+
+bool Portfolio::witness(std::vector<UnorderedTermMap> & out)
+{
+  if (winner_idx_ < 0 || results_[winner_idx_] != ProverResult::FALSE) {
+    throw PonoException(
+        "Recovering witness failed. No engine in the portfolio found a "
+        "counterexample.");
+  }
+  return workers_[winner_idx_]->witness(out);
+}
+
+Engine Portfolio::winner() const
+{
+  return (winner_idx_ < 0) ? Engine::NONE : engines_[winner_idx_];
+}
+
+shared_ptr<Prover> Portfolio::make_worker(Engine e)
+{
+  PonoOptions opts = options_;
+  opts.engine_ = e;
+
+  SmtSolver s;
+  if (e == INTERP) {
+#ifdef WITH_MSAT
+    s = create_solver(MSAT);
+#else
+    throw PonoException(engine_name(e) + " requires MathSAT");
+#endif
+  } else {
+    s = create_solver(solver_->get_solver_enum());
+  }
+
+  // workers are built from the original system so that witnesses and
+  // invariants come back in terms of the original solver
+  shared_ptr<Prover> w = make_prover(e, orig_property_, orig_ts_, s, opts);
+  w->initialize();
+  if (bus_) {
+    // the id is the index this worker will get in workers_
+    w->set_lemma_bus(bus_, workers_.size());
+  }
+  return w;
+}
+
+void Portfolio::run_worker(size_t idx, int k)
+{
+  Prover & w = *workers_[idx];
+  ProverResult r = ProverResult::UNKNOWN;
+  try {
+    // engines are incremental in the bound, so this only does
+    // the work for one more bound per iteration
+    for (int j = 0; j <= k && !cancel_; ++j) {
+      r = w.check_until(j);
+      if (r != ProverResult::UNKNOWN) {
+        break;
+      }
+    }
+  }
+  catch (std::exception & e) {
+    logger.log(1,
+               "Portfolio: engine {} failed -- {}",
+               engine_name(engines_[idx]),
+               e.what());
+    r = ProverResult::UNKNOWN;
+  }
+
+  results_[idx] = r;
+  if (r == ProverResult::TRUE || r == ProverResult::FALSE) {
+    bool expected = false;
+    // only the first decisive engine becomes the winner
+    if (cancel_.compare_exchange_strong(expected, true)) {
+      winner_idx_ = idx;
+    }
+  }
+}
+
+}  // namespace pono
@@ -0,0 +1,82 @@
+/*********************                                                        */
+/*! \file portfolio.h
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief In-process portfolio that races several engines on threads.
+**
+**        Each engine gets its own solver and its own copy of the
+**        transition system (transferred with a TermTranslator before
+**        any thread is started, because term translation reads the
+**        source solver). The first engine to return TRUE or FALSE wins
+**        and the others are cancelled at their next bound.
+**        Optionally, the engines exchange lemmas over a LemmaBus.
+**
+**/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "engines/prover.h"
+
+namespace pono {
+
+class Portfolio : public Prover
+{
+ public:
+  Portfolio(const Property & p,
+            const TransitionSystem & ts,
+            const smt::SmtSolver & solver,
+            PonoOptions opt = PonoOptions());
+
+  ~Portfolio();
+
+  typedef Prover super;
+
+  void initialize() override;
+
+  ProverResult check_until(int k) override;
+
+  bool witness(std::vector<smt::UnorderedTermMap> & out) override;
+
+  /** @return the engine that decided the property
+   *  or Engine::NONE if no engine has returned TRUE or FALSE yet
+   */
+  Engine winner() const;
+
+ protected:
+  /** Creates a worker prover for engine e with a fresh solver
+   *  Must be called from the main thread
+   *  @param e the engine to instantiate
+   *  @return the new prover, already initialized
+   */
+  std::shared_ptr<Prover> make_worker(Engine e);
+
+  /** Body of a worker thread
+   *  Calls check_until with increasing bounds up to k,
+   *  polling the cancel flag between bounds
+   *  @param idx the index of the worker in workers_
+   *  @param k the bound to check until
+   */
+  void run_worker(size_t idx, int k);
+
+  std::vector<Engine> engines_;  ///< engines that were successfully created
+  std::vector<std::shared_ptr<Prover>> workers_;
+  std::vector<ProverResult> results_;  ///< last result of each worker
+
+  std::shared_ptr<LemmaBus> bus_;  ///< null unless sharing lemmas
+
+  std::atomic<bool> cancel_;  ///< set once a worker decides the property
+  int winner_idx_;            ///< index into workers_ or -1
+};
+
+}  // namespace pono
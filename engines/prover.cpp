@@ -40,7 +40,10 @@ Prover::Prover(const Property & p, const TransitionSystem & ts,
       ts_(ts, to_prover_solver_),
       unroller_(ts_, solver_),
       options_(opt),
-      engine_(Engine::NONE)
+      engine_(Engine::NONE),
+      lemma_bus_id_(0),
+      lemma_cursor_(nullptr),
+      num_activation_lits_(0)
 {
 }
 
@@ -169,6 +172,43 @@ Term Prover::invar()
   return to_orig_ts(invar_, BOOL);
 }
 
+void Prover::set_lemma_bus(shared_ptr<LemmaBus> bus, size_t id)
+{
+  lemma_bus_ = bus;
+  lemma_bus_id_ = id;
+  lemma_cursor_ = nullptr;
+}
+
+void Prover::publish_lemma(const Term & lemma)
+{
+  if (lemma_bus_) {
+    lemma_bus_->publish(lemma_bus_id_, lemma);
+  }
+}
+
+TermVec Prover::fetch_lemmas()
+{
+  if (!lemma_bus_) {
+    return {};
+  }
+  return lemma_bus_->fetch(lemma_bus_id_, lemma_cursor_, ts_);
+}
+
+Term Prover::make_activation_lit(const string & prefix)
+{
+  Sort boolsort = solver_->make_sort(BOOL);
+  while (true) {
+    try {
+      return solver_->make_symbol(
+          "__" + prefix + "_" + std::to_string(num_activation_lits_++),
+          boolsort);
+    }
+    catch (IncorrectUsageException & e) {
+      // name already taken, try the next one
+    }
+  }
+}
+
 Term Prover::to_orig_ts(Term t, SortKind sk)
 {
   if (solver_ == orig_ts_.solver()) {
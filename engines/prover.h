@@ -21,6 +21,7 @@
 #include "core/ts.h"
 #include "core/unroller.h"
 #include "options/options.h"
+#include "utils/lemma_bus.h"
 
 #include "smt-switch/smt.h"
 
@@ -59,7 +60,36 @@ class Prover
    */
   smt::Term invar();
 
+  /** Connect this prover to a bus shared with other provers
+   *  Engines that learn lemmas publish them on the bus and
+   *  engines that can use lemmas import them at safe points
+   *  @param bus the shared lemma bus
+   *  @param id unique id of this prover on the bus
+   */
+  void set_lemma_bus(std::shared_ptr<LemmaBus> bus, size_t id);
+
  protected:
+  /** Publish a lemma on the lemma bus (if there is one)
+   *  @param lemma a term over current state variables
+   *         that holds in all reachable states up to some bound
+   */
+  void publish_lemma(const smt::Term & lemma);
+
+  /** Fetch lemmas published by other provers since the last call
+   *  @return new lemmas over state variables of ts_
+   *          these are unchecked and must be validated by the caller
+   */
+  smt::TermVec fetch_lemmas();
+
+  /** Create a fresh boolean symbol to be used as an activation literal
+   *  e.g. assert lit -> formula and then check_sat_assuming({ lit })
+   *  instead of push/assert/pop
+   *  A literal can be retired by asserting its negation
+   *  @param prefix a prefix for the name of the symbol
+   *  @return the new literal
+   */
+  smt::Term make_activation_lit(const std::string & prefix);
+
   /** Take a term from the Prover's solver
    *  to the original transition system's solver
    *  as a particular SortKind
@@ -114,5 +144,11 @@ class Prover
 
   smt::Term invar_; ///< populated with an invariant if the engine supports it
 
+  std::shared_ptr<LemmaBus> lemma_bus_;  ///< null unless sharing lemmas
+  size_t lemma_bus_id_;
+  LemmaBus::Cursor lemma_cursor_;
+
+  size_t num_activation_lits_;  ///< for unique activation literal names
+
 };
 }  // namespace pono
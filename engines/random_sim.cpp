@@ -0,0 +1,124 @@
+/*********************                                                        */
+/*! \file random_sim.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Bug hunting with bit-parallel random simulation.
+**
+**
+**/
+
+#include "engines/random_sim.h"
+
+#include "utils/exceptions.h"
+#include "utils/logger.h"
+
+using namespace smt;
+using namespace std;
+
+namespace pono {
+
+RandomSimulation::RandomSimulation(const Property & p,
+                                   const TransitionSystem & ts,
+                                   const SmtSolver & solver,
+                                   PonoOptions opt)
+    : super(p, ts, solver, opt)
+{
+  engine_ = Engine::SIM;
+}
+
+RandomSimulation::~RandomSimulation() {}
+
+void RandomSimulation::initialize()
+{
+  if (initialized_) {
+    return;
+  }
+
+  super::initialize();
+
+  if (!ts_.is_functional()) {
+    throw PonoException("Simulation requires a functional transition system");
+  }
+
+  sim_.reset(new Simulator(ts_, options_.random_seed_));
+  if (!sim_->exact()) {
+    // a hit might not be a real counterexample
+    throw PonoException(
+        "Simulation does not support all the operators or sorts of the "
+        "transition system");
+  }
+  sim_->add_term(bad_);
+
+  named_terms_.clear();
+  for (const auto & elem : ts_.named_terms()) {
+    try {
+      sim_->add_term(elem.second);
+      named_terms_.push_back(elem.second);
+    }
+    catch (PonoException & e) {
+      logger.log(2, "Simulation: not recording {} -- {}", elem.first, e.what());
+    }
+  }
+}
+
+ProverResult RandomSimulation::check_until(int k)
+{
+  initialize();
+
+  for (unsigned int run = 0; run < options_.sim_runs_; ++run) {
+    logger.log(1, "Simulation run {}", run);
+    sim_->reset();
+    for (int i = 0; i <= k; ++i) {
+      if (i) {
+        sim_->step();
+      }
+      uint64_t valid = sim_->valid_lanes();
+      if (!valid) {
+        // every lane violated init or a constraint
+        break;
+      }
+      uint64_t hit = sim_->bits(bad_)[0] & valid;
+      if (hit) {
+        size_t lane = __builtin_ctzll(hit);
+        logger.log(1, "Simulation reached bad at bound {} in run {}", i, run);
+        reached_k_ = i;
+        record_witness(lane, i);
+        return ProverResult::FALSE;
+      }
+    }
+  }
+
+  return ProverResult::UNKNOWN;
+}
+
+void RandomSimulation::record_witness(size_t lane, size_t cycle)
+{
+  witness_.clear();
+  sim_->rewind();
+  for (size_t i = 0; i <= cycle; ++i) {
+    if (i) {
+      sim_->step();
+    }
+    witness_.push_back(UnorderedTermMap());
+    UnorderedTermMap & map = witness_.back();
+
+    for (const auto & v : ts_.statevars()) {
+      map[v] = sim_->value(v, lane);
+    }
+    for (const auto & v : ts_.inputvars()) {
+      map[v] = sim_->value(v, lane);
+    }
+    for (const auto & t : named_terms_) {
+      map[t] = sim_->value(t, lane);
+    }
+  }
+}
+
+}  // namespace pono
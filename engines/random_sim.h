@@ -0,0 +1,57 @@
+/*********************                                                        */
+/*! \file random_sim.h
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Bug hunting with bit-parallel random simulation.
+**
+**        Simulates Simulator::num_lanes random stimuli at a time up to
+**        the bound and reports the first lane that reaches bad. It can
+**        only find counterexamples, otherwise the result is unknown.
+**
+**/
+
+#pragma once
+
+#include <memory>
+
+#include "core/simulator.h"
+#include "engines/prover.h"
+
+namespace pono {
+
+class RandomSimulation : public Prover
+{
+ public:
+  RandomSimulation(const Property & p,
+                   const TransitionSystem & ts,
+                   const smt::SmtSolver & solver,
+                   PonoOptions opt = PonoOptions());
+
+  ~RandomSimulation();
+
+  typedef Prover super;
+
+  void initialize() override;
+
+  ProverResult check_until(int k) override;
+
+ protected:
+  /** Replays the current run of the simulator and records the values
+   *  of one lane into witness_
+   *  @param lane the lane that reached bad
+   *  @param cycle the cycle at which it reached bad
+   */
+  void record_witness(size_t lane, size_t cycle);
+
+  std::unique_ptr<Simulator> sim_;
+  smt::TermVec named_terms_;  ///< named terms the simulator can evaluate
+};
+
+}  // namespace pono
@@ -0,0 +1,320 @@
+/*********************                                                  */
+/*! \file state_var_merger.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Sequential equivalence reduction for functional transition
+**        systems.
+**
+**
+**/
+
+#include "modifiers/state_var_merger.h"
+
+#include <algorithm>
+#include <map>
+
+#include "core/simulator.h"
+#include "core/unroller.h"
+#include "modifiers/ts_simplifier.h"
+#include "smt-switch/term_translator.h"
+#include "smt/available_solvers.h"
+#include "utils/exceptions.h"
+#include "utils/logger.h"
+
+using namespace smt;
+using namespace std;
+
+namespace pono {
+
+StateVarMerger::StateVarMerger(TransitionSystem & ts,
+                               unsigned int k,
+                               unsigned int sim_runs,
+                               unsigned int sim_cycles,
+                               unsigned int seed)
+    : ts_(ts),
+      k_(k),
+      sim_runs_(sim_runs),
+      sim_cycles_(sim_cycles),
+      seed_(seed)
+{
+  if (!k_) {
+    throw PonoException("StateVarMerger requires an induction depth > 0");
+  }
+}
+
+size_t StateVarMerger::merge(TermVec & terms)
+{
+  if (!ts_.is_functional()) {
+    throw PonoException(
+        "Merging state variables requires a functional transition system");
+  }
+
+  size_t orig_num_statevars = ts_.statevars().size();
+  logger.log(1, "Starting state variable merging:");
+  logger.log(1, "  - state variables: {}", orig_num_statevars);
+
+  find_candidates();
+  logger.log(1, "  - candidate classes from simulation: {}", classes_.size());
+
+  prove_candidates();
+  logger.log(1, "  - proven classes: {}", classes_.size());
+
+  UnorderedTermMap merged = merge_map();
+  if (merged.size()) {
+    merge_statevars(ts_, merged, terms);
+  }
+
+  logger.log(1,
+             "State variable merging completed: {} remaining state "
+             "variables, {} original",
+             ts_.statevars().size(),
+             orig_num_statevars);
+  return merged.size();
+}
+
+void StateVarMerger::find_candidates()
+{
+  classes_.clear();
+
+  Simulator sim(ts_, seed_);
+  TermVec vars;
+  for (const auto & v : ts_.statevars()) {
+    // arrays are not compared
+    if (sim.has_update(v) && sim.width(v)) {
+      vars.push_back(v);
+    }
+  }
+
+  // signature of the values of each variable in all valid lanes
+  unordered_map<Term, uint64_t> sig;
+  // whether a variable had the same value in all valid lanes and cycles
+  unordered_map<Term, bool> uniform;
+  unordered_map<Term, vector<bool>> uniform_bits;
+  for (const auto & v : vars) {
+    sig[v] = 0;
+    uniform[v] = true;
+  }
+
+  for (unsigned int run = 0; run < sim_runs_; ++run) {
+    sim.reset();
+    for (unsigned int cyc = 0; cyc < sim_cycles_; ++cyc) {
+      if (cyc) {
+        sim.step();
+      }
+      uint64_t valid = sim.valid_lanes();
+      if (!valid) {
+        // every lane violated init or a constraint
+        break;
+      }
+
+      for (const auto & v : vars) {
+        const uint64_t * b = sim.bits(v);
+        size_t w = sim.width(v);
+        uint64_t & h = sig[v];
+        vector<bool> & ub = uniform_bits[v];
+        bool first = ub.empty();
+        for (size_t j = 0; j < w; ++j) {
+          uint64_t m = b[j] & valid;
+          h ^= m + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+
+          if (!uniform[v]) {
+            continue;
+          } else if (m != 0 && m != valid) {
+            uniform[v] = false;
+          } else if (first) {
+            ub.push_back(m != 0);
+          } else if (ub[j] != (m != 0)) {
+            uniform[v] = false;
+          }
+        }
+      }
+    }
+  }
+
+  // group by sort and signature
+  map<pair<string, uint64_t>, TermVec> groups;
+  for (const auto & v : vars) {
+    groups[{ v->get_sort()->to_string(), sig.at(v) }].push_back(v);
+  }
+
+  for (const auto & elem : groups) {
+    const TermVec & group = elem.second;
+    Class c;
+    c.vars = group;
+
+    const Term & v = group[0];
+    const vector<bool> & ub = uniform_bits[v];
+    if (uniform.at(v) && ub.size()) {
+      Sort sort = v->get_sort();
+      if (sort->get_sort_kind() == BOOL) {
+        c.val = ts_.make_term(bool(ub[0]));
+      } else {
+        string bin;
+        for (size_t j = ub.size(); j-- > 0;) {
+          bin.push_back(ub[j] ? '1' : '0');
+        }
+        c.val = ts_.make_term(bin, sort, 2);
+      }
+    }
+
+    if (c.val || c.vars.size() > 1) {
+      classes_.push_back(c);
+    }
+  }
+}
+
+void StateVarMerger::prove_candidates()
+{
+  if (classes_.empty()) {
+    return;
+  }
+
+  // use a fresh solver, the unrolled symbols would clash
+  // with the ones created by an engine on the original solver
+  SmtSolver solver = create_solver(ts_.solver()->get_solver_enum());
+  solver->set_opt("incremental", "true");
+  TermTranslator tt(solver);
+  TransitionSystem ts(ts_, tt);
+  Unroller un(ts, solver);
+
+  vector<UnorderedTermMap> to_solver(k_ + 1);
+  for (size_t t = 0; t <= k_; ++t) {
+    for (const auto & c : classes_) {
+      for (const auto & v : c.vars) {
+        to_solver[t][v] = un.at_time(tt.transfer_term(v), t);
+      }
+      if (c.val) {
+        to_solver[t][c.val] = tt.transfer_term(c.val);
+      }
+    }
+  }
+
+  auto candidates_at = [&](size_t t) {
+    Term res = solver->make_term(true);
+    for (const auto & c : classes_) {
+      Term rep = representative(c);
+      Term solver_rep = to_solver[t].at(rep);
+      for (const auto & v : c.vars) {
+        if (v != rep) {
+          Term eq =
+              solver->make_term(Equal, to_solver[t].at(v), solver_rep);
+          res = solver->make_term(And, res, eq);
+        }
+      }
+    }
+    return res;
+  };
+
+  // splits classes until the candidates at time t follow from the
+  // current assertions and (if assume) the candidates at times 0..t-1
+  // gives up on all candidates if the solver returns unknown
+  auto refine_until_unsat = [&](size_t t, bool assume) {
+    while (classes_.size()) {
+      solver->push();
+      if (assume) {
+        for (size_t i = 0; i < t; ++i) {
+          solver->assert_formula(candidates_at(i));
+        }
+      }
+      solver->assert_formula(solver->make_term(Not, candidates_at(t)));
+      Result r = solver->check_sat();
+      if (r.is_sat()) {
+        refine(solver, to_solver[t]);
+      } else if (r.is_unknown()) {
+        classes_.clear();
+      }
+      solver->pop();
+      if (r.is_unsat()) {
+        break;
+      }
+    }
+  };
+
+  // base case: candidates hold in the first k steps
+  solver->push();
+  solver->assert_formula(un.at_time(ts.init(), 0));
+  for (size_t t = 0; t < k_; ++t) {
+    if (t) {
+      solver->assert_formula(un.at_time(ts.trans(), t - 1));
+    }
+    refine_until_unsat(t, false);
+  }
+  solver->pop();
+
+  // inductive step: k consecutive steps satisfying the candidates
+  // are followed by a step satisfying them
+  // (classes only get split, so the base case still holds)
+  for (size_t t = 0; t < k_; ++t) {
+    solver->assert_formula(un.at_time(ts.trans(), t));
+  }
+  refine_until_unsat(k_, true);
+}
+
+void StateVarMerger::refine(const SmtSolver & solver,
+                            const UnorderedTermMap & to_solver)
+{
+  vector<Class> new_classes;
+  for (const auto & c : classes_) {
+    Term const_key = c.val ? solver->get_value(to_solver.at(c.val)) : nullptr;
+    unordered_map<Term, size_t> key2class;
+    size_t start = new_classes.size();
+    for (const auto & v : c.vars) {
+      Term key = solver->get_value(to_solver.at(v));
+      auto it = key2class.find(key);
+      if (it == key2class.end()) {
+        key2class[key] = new_classes.size();
+        Class nc;
+        nc.val = (key == const_key) ? c.val : nullptr;
+        nc.vars.push_back(v);
+        new_classes.push_back(nc);
+      } else {
+        new_classes[it->second].vars.push_back(v);
+      }
+    }
+
+    // drop trivial classes
+    size_t end = start;
+    for (size_t i = start; i < new_classes.size(); ++i) {
+      if (new_classes[i].val || new_classes[i].vars.size() > 1) {
+        new_classes[end++] = new_classes[i];
+      }
+    }
+    new_classes.resize(end);
+  }
+  classes_ = new_classes;
+}
+
+Term StateVarMerger::representative(const Class & c) const
+{
+  if (c.val) {
+    return c.val;
+  }
+  // the variable with the least name, to be deterministic
+  return *std::min_element(
+      c.vars.begin(), c.vars.end(), [](const Term & a, const Term & b) {
+        return a->to_string() < b->to_string();
+      });
+}
+
+UnorderedTermMap StateVarMerger::merge_map() const
+{
+  UnorderedTermMap res;
+  for (const auto & c : classes_) {
+    Term rep = representative(c);
+    for (const auto & v : c.vars) {
+      if (v != rep) {
+        res[v] = rep;
+      }
+    }
+  }
+  return res;
+}
+
+}  // namespace pono
@@ -0,0 +1,90 @@
+/*********************                                                  */
+/*! \file state_var_merger.h
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Sequential equivalence reduction for functional transition
+**        systems.
+**
+**        Random simulation proposes classes of state variables that
+**        look equal (or constant). The classes are then proven with
+**        k-induction on a fresh solver, splitting classes refuted by a
+**        model until the remaining ones are inductive. Finally, every
+**        proven class is merged into its representative.
+**
+**/
+
+#pragma once
+
+#include "core/ts.h"
+
+namespace pono {
+
+class StateVarMerger
+{
+ public:
+  /** @param ts the functional transition system to reduce (in place)
+   *  @param k the induction depth for proving candidate classes
+   *  @param sim_runs number of simulation runs (of Simulator::num_lanes
+   *         stimuli each)
+   *  @param sim_cycles number of cycles in each simulation run
+   *  @param seed the seed for the random stimuli
+   */
+  StateVarMerger(TransitionSystem & ts,
+                 unsigned int k = 1,
+                 unsigned int sim_runs = 4,
+                 unsigned int sim_cycles = 64,
+                 unsigned int seed = 0);
+
+  /** Finds, proves and merges equivalent state variables
+   *  @param terms other terms over ts (e.g. properties), rewritten in place
+   *  @return the number of state variables removed
+   */
+  size_t merge(smt::TermVec & terms);
+
+ protected:
+  /** A candidate class of equivalent state variables
+   *  if val is non-null, all of them are candidates for being that value
+   */
+  struct Class
+  {
+    smt::Term val;
+    smt::TermVec vars;
+  };
+
+  /** Simulates the system and fills classes_ with candidates */
+  void find_candidates();
+
+  /** Refines classes_ until the candidates are k-inductive */
+  void prove_candidates();
+
+  /** Splits classes by the values of their variables in a model
+   *  @param solver the solver holding the model
+   *  @param to_solver map from state variables to their version
+   *         in the solver at the time of interest
+   */
+  void refine(const smt::SmtSolver & solver,
+              const smt::UnorderedTermMap & to_solver);
+
+  /** @return the representative of class c */
+  smt::Term representative(const Class & c) const;
+
+  /** @return map from every merged variable to its representative */
+  smt::UnorderedTermMap merge_map() const;
+
+  TransitionSystem & ts_;
+  unsigned int k_;
+  unsigned int sim_runs_;
+  unsigned int sim_cycles_;
+  unsigned int seed_;
+
+  std::vector<Class> classes_;
+};
+
+}  // namespace pono
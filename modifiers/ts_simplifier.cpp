@@ -0,0 +1,600 @@
+/*********************                                                  */
+/*! \file ts_simplifier.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Static (i.e., one-time before solving) simplification of a
+**        transition system.
+**
+**
+**/
+
+#include "modifiers/ts_simplifier.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "utils/exceptions.h"
+#include "utils/logger.h"
+
+using namespace smt;
+using namespace std;
+
+namespace pono {
+
+/** Less than comparison of the hash of two terms
+ *  gives commutative operators a canonical operand order
+ */
+static bool term_hash_lt(const Term & t0, const Term & t1)
+{
+  return (t0->hash() < t1->hash());
+}
+
+static bool is_commutative(PrimOp po)
+{
+  switch (po) {
+    case And:
+    case Or:
+    case Xor:
+    case Equal:
+    case BVAnd:
+    case BVOr:
+    case BVXor:
+    case BVAdd:
+    case BVMul: return true;
+    default: return false;
+  }
+}
+
+static Term first_child(const Term & t)
+{
+  assert(t->begin() != t->end());
+  return *(t->begin());
+}
+
+static TermVec get_children(const Term & t)
+{
+  TermVec children;
+  for (const auto & c : t) {
+    children.push_back(c);
+  }
+  return children;
+}
+
+void merge_statevars(TransitionSystem & ts,
+                     const UnorderedTermMap & merged,
+                     TermVec & terms)
+{
+  // the next state versions are only needed for the other terms
+  UnorderedTermMap to_replace;
+  for (const auto & elem : merged) {
+    const Term & v = elem.first;
+    const Term & rep = elem.second;
+    assert(ts.is_curr_var(v));
+    assert(rep->is_value() || ts.is_curr_var(rep));
+    to_replace[v] = rep;
+    to_replace[ts.next(v)] = rep->is_value() ? rep : ts.next(rep);
+  }
+
+  ts.merge_statevars(merged);
+
+  const SmtSolver & solver = ts.solver();
+  for (auto & t : terms) {
+    t = solver->substitute(t, to_replace);
+  }
+}
+
+TransitionSystemSimplifier::TransitionSystemSimplifier(TransitionSystem & ts)
+    : ts_(ts),
+      solver_(ts.solver()),
+      true_(solver_->make_term(true)),
+      false_(solver_->make_term(false)),
+      num_merged_(0)
+{
+}
+
+void TransitionSystemSimplifier::simplify(TermVec & terms, bool merge)
+{
+  size_t orig_size = dag_size();
+  size_t orig_num_statevars = ts_.statevars().size();
+  logger.log(1, "Starting transition system simplification:");
+  logger.log(1, "  - state variables: {}", orig_num_statevars);
+  logger.log(1, "  - DAG size: {}", orig_size);
+
+  simplify_ts();
+  for (auto & t : terms) {
+    t = simplify_term(t);
+  }
+
+  if (merge && ts_.is_functional()) {
+    UnorderedTermMap merged = find_equivalent_statevars();
+    if (merged.size()) {
+      merge_statevars(ts_, merged, terms);
+      for (auto & t : terms) {
+        t = simplify_term(t);
+      }
+      simplify_ts();
+      num_merged_ = merged.size();
+    }
+  }
+
+  logger.log(1,
+             "Simplification completed: {} remaining state variables, {} "
+             "original",
+             ts_.statevars().size(),
+             orig_num_statevars);
+  logger.log(1,
+             "Simplification completed: DAG size {}, {} original",
+             dag_size(),
+             orig_size);
+}
+
+Term TransitionSystemSimplifier::simplify_term(const Term & t)
+{
+  TermVec to_visit({ t });
+  UnorderedTermSet visited;
+  TermVec children;
+  while (to_visit.size()) {
+    Term n = to_visit.back();
+
+    if (cache_.find(n) != cache_.end()) {
+      to_visit.pop_back();
+      continue;
+    }
+
+    Op op = n->get_op();
+    if (n->is_symbolic_const() || n->is_value() || op.is_null()) {
+      to_visit.pop_back();
+      cache_[n] = n;
+      continue;
+    }
+
+    if (visited.insert(n).second) {
+      for (const auto & c : n) {
+        to_visit.push_back(c);
+      }
+      continue;
+    }
+
+    to_visit.pop_back();
+    children.clear();
+    for (const auto & c : n) {
+      children.push_back(cache_.at(c));
+    }
+    Term res = rewrite(op, children);
+    cache_[n] = res;
+    // the rewritten term is already simplified
+    cache_[res] = res;
+  }
+
+  return cache_.at(t);
+}
+
+Term TransitionSystemSimplifier::rewrite(const Op & op, TermVec & children)
+{
+  const PrimOp po = op.prim_op;
+  switch (po) {
+    case Not: {
+      const Term & c = children[0];
+      if (c == true_) {
+        return false_;
+      } else if (c == false_) {
+        return true_;
+      } else if (c->get_op() == Not) {
+        return first_child(c);
+      }
+      break;
+    }
+    case And:
+    case Or: {
+      const Term & absorbing = (po == And) ? false_ : true_;
+      const Term & neutral = (po == And) ? true_ : false_;
+      TermVec args;
+      UnorderedTermSet seen;
+      for (const auto & c : children) {
+        if (c == absorbing) {
+          return absorbing;
+        } else if (c != neutral && seen.insert(c).second) {
+          args.push_back(c);
+        }
+      }
+      for (const auto & a : args) {
+        // x and not x
+        if (a->get_op() == Not && seen.find(first_child(a)) != seen.end()) {
+          return absorbing;
+        }
+      }
+      if (args.empty()) {
+        return neutral;
+      } else if (args.size() == 1) {
+        return args[0];
+      }
+      children = args;
+      break;
+    }
+    case Implies: {
+      const Term & a = children[0];
+      const Term & b = children[1];
+      if (a == true_) {
+        return b;
+      } else if (a == false_ || b == true_ || a == b) {
+        return true_;
+      } else if (b == false_) {
+        TermVec args({ a });
+        return rewrite(Op(Not), args);
+      }
+      break;
+    }
+    case Xor: {
+      if (children.size() != 2) {
+        break;
+      }
+      Term a = children[0];
+      Term b = children[1];
+      if (a == b) {
+        return false_;
+      }
+      if (a == true_ || a == false_) {
+        std::swap(a, b);
+      }
+      if (b == false_) {
+        return a;
+      } else if (b == true_) {
+        TermVec args({ a });
+        return rewrite(Op(Not), args);
+      }
+      break;
+    }
+    case Equal: {
+      if (children.size() != 2) {
+        break;
+      }
+      Term a = children[0];
+      Term b = children[1];
+      if (a == b) {
+        return true_;
+      }
+      SortKind sk = a->get_sort()->get_sort_kind();
+      if (a->is_value() && b->is_value() && (sk == BOOL || sk == BV)) {
+        // values are hash-consed, so these are different values
+        return false_;
+      }
+      if (sk == BOOL) {
+        if (a == true_ || a == false_) {
+          std::swap(a, b);
+        }
+        if (b == true_) {
+          return a;
+        } else if (b == false_) {
+          TermVec args({ a });
+          return rewrite(Op(Not), args);
+        }
+      }
+      break;
+    }
+    case Distinct: {
+      if (children.size() == 2 && children[0] == children[1]) {
+        return false_;
+      }
+      break;
+    }
+    case Ite: {
+      const Term & c = children[0];
+      const Term & a = children[1];
+      const Term & b = children[2];
+      if (c == true_ || a == b) {
+        return a;
+      } else if (c == false_) {
+        return b;
+      } else if (a == true_ && b == false_) {
+        return c;
+      } else if (a == false_ && b == true_) {
+        TermVec args({ c });
+        return rewrite(Op(Not), args);
+      }
+      break;
+    }
+    case Extract: {
+      const Term & x = children[0];
+      uint64_t hi = op.idx0;
+      uint64_t lo = op.idx1;
+      if (lo == 0 && hi + 1 == x->get_sort()->get_width()) {
+        return x;
+      }
+
+      Op xop = x->get_op();
+      if (xop.prim_op == Extract) {
+        // slice of a slice
+        TermVec args({ first_child(x) });
+        return rewrite(Op(Extract, hi + xop.idx1, lo + xop.idx1), args);
+      } else if (xop.prim_op == Concat) {
+        TermVec xc = get_children(x);
+        if (xc.size() == 2) {
+          uint64_t lsb_width = xc[1]->get_sort()->get_width();
+          if (hi < lsb_width) {
+            // only the least significant part
+            TermVec args({ xc[1] });
+            return rewrite(op, args);
+          } else if (lo >= lsb_width) {
+            // only the most significant part
+            TermVec args({ xc[0] });
+            return rewrite(Op(Extract, hi - lsb_width, lo - lsb_width), args);
+          }
+        }
+      }
+      break;
+    }
+    case Concat: {
+      if (children.size() != 2) {
+        break;
+      }
+      // adjacent slices of the same term
+      const Term & a = children[0];
+      const Term & b = children[1];
+      Op aop = a->get_op();
+      Op bop = b->get_op();
+      if (aop.prim_op == Extract && bop.prim_op == Extract
+          && first_child(a) == first_child(b) && aop.idx1 == bop.idx0 + 1) {
+        TermVec args({ first_child(a) });
+        return rewrite(Op(Extract, aop.idx0, bop.idx1), args);
+      }
+      break;
+    }
+    default: break;
+  }
+
+  Term folded = fold_bv(op, children);
+  if (folded) {
+    return folded;
+  }
+
+  if (children.size() == 2
+      && (po == BVAdd || po == BVOr || po == BVXor || po == BVAnd
+          || po == BVMul)) {
+    Sort sort = children[0]->get_sort();
+    Term zero = solver_->make_term(0, sort);
+    for (size_t i = 0; i < 2; ++i) {
+      const Term & c = children[i];
+      const Term & other = children[1 - i];
+      if (c == zero) {
+        return (po == BVAnd || po == BVMul) ? zero : other;
+      } else if (po == BVMul && c == solver_->make_term(1, sort)) {
+        return other;
+      }
+    }
+  }
+
+  if (is_commutative(po)) {
+    std::stable_sort(children.begin(), children.end(), term_hash_lt);
+  }
+
+  // the solver hash-conses terms, so structurally equal terms
+  // are identical after this
+  return solver_->make_term(op, children);
+}
+
+Term TransitionSystemSimplifier::fold_bv(const Op & op,
+                                         const TermVec & children)
+{
+  if (children.empty()) {
+    return nullptr;
+  }
+
+  vector<uint64_t> vals;
+  for (const auto & c : children) {
+    Sort sort = c->get_sort();
+    if (!c->is_value() || sort->get_sort_kind() != BV
+        || sort->get_width() > 63) {
+      return nullptr;
+    }
+    try {
+      vals.push_back(c->to_int());
+    }
+    catch (std::exception & e) {
+      return nullptr;
+    }
+  }
+
+  const PrimOp po = op.prim_op;
+  const bool binary = (vals.size() == 2);
+  uint64_t width = children[0]->get_sort()->get_width();
+  uint64_t res;
+  switch (po) {
+    case BVNot: res = ~vals[0]; break;
+    case BVNeg: res = -vals[0]; break;
+    case Extract:
+      width = op.idx0 - op.idx1 + 1;
+      res = vals[0] >> op.idx1;
+      break;
+    case Concat: {
+      if (!binary) {
+        return nullptr;
+      }
+      uint64_t lsb_width = children[1]->get_sort()->get_width();
+      width += lsb_width;
+      if (width > 63) {
+        return nullptr;
+      }
+      res = (vals[0] << lsb_width) | vals[1];
+      break;
+    }
+    default: {
+      if (!binary) {
+        return nullptr;
+      }
+      uint64_t a = vals[0];
+      uint64_t b = vals[1];
+      switch (po) {
+        case BVAnd: res = a & b; break;
+        case BVOr: res = a | b; break;
+        case BVXor: res = a ^ b; break;
+        case BVAdd: res = a + b; break;
+        case BVSub: res = a - b; break;
+        case BVMul: res = a * b; break;
+        case BVShl: res = (b >= width) ? 0 : (a << b); break;
+        case BVLshr: res = (b >= width) ? 0 : (a >> b); break;
+        case BVUlt: return (a < b) ? true_ : false_;
+        case BVUle: return (a <= b) ? true_ : false_;
+        case BVUgt: return (a > b) ? true_ : false_;
+        case BVUge: return (a >= b) ? true_ : false_;
+        default: return nullptr;
+      }
+    }
+  }
+
+  res &= (1ull << width) - 1;
+  return solver_->make_term((int64_t)res, solver_->make_sort(BV, width));
+}
+
+void TransitionSystemSimplifier::simplify_ts()
+{
+  // only the roots need to be replaced, the SubstitutionWalker
+  // in replace_terms doesn't descend into a replaced term
+  UnorderedTermMap to_replace;
+  auto add_root = [this, &to_replace](const Term & t) {
+    Term st = simplify_term(t);
+    if (st != t) {
+      to_replace[t] = st;
+    }
+  };
+
+  add_root(ts_.init());
+  add_root(ts_.trans());
+  for (const auto & elem : ts_.state_updates()) {
+    add_root(elem.second);
+  }
+  for (const auto & c : ts_.constraints()) {
+    add_root(c);
+  }
+
+  if (to_replace.size()) {
+    ts_.replace_terms(to_replace);
+  }
+}
+
+UnorderedTermMap TransitionSystemSimplifier::find_equivalent_statevars()
+{
+  assert(ts_.is_functional());
+  const UnorderedTermMap & updates = ts_.state_updates();
+
+  // find the state variables with a constant initial value
+  UnorderedTermMap init_vals;
+  TermVec to_visit({ ts_.init() });
+  while (to_visit.size()) {
+    Term t = to_visit.back();
+    to_visit.pop_back();
+    PrimOp po = t->get_op().prim_op;
+    if (po == And) {
+      for (const auto & c : t) {
+        to_visit.push_back(c);
+      }
+    } else if (po == Equal) {
+      TermVec eq = get_children(t);
+      if (eq.size() != 2) {
+        continue;
+      }
+      if (eq[0]->is_value()) {
+        std::swap(eq[0], eq[1]);
+      }
+      if (ts_.is_curr_var(eq[0]) && eq[1]->is_value()
+          && updates.find(eq[0]) != updates.end()) {
+        init_vals[eq[0]] = eq[1];
+      }
+    }
+  }
+
+  // initial partition: same initial value, optimistically constant
+  vector<TermVec> classes;
+  vector<Term> class_vals;
+  vector<bool> is_const;
+  unordered_map<Term, size_t> val2class;
+  for (const auto & elem : init_vals) {
+    auto it = val2class.find(elem.second);
+    if (it == val2class.end()) {
+      val2class[elem.second] = classes.size();
+      classes.push_back({ elem.first });
+      class_vals.push_back(elem.second);
+      is_const.push_back(true);
+    } else {
+      classes[it->second].push_back(elem.first);
+    }
+  }
+
+  UnorderedTermMap subst;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+
+    // assume every variable is equal to its representative
+    // (the value or, to be deterministic, the variable with the least name)
+    subst.clear();
+    for (size_t i = 0; i < classes.size(); ++i) {
+      Term rep = class_vals[i];
+      if (!is_const[i]) {
+        rep = *std::min_element(classes[i].begin(),
+                                classes[i].end(),
+                                [](const Term & a, const Term & b) {
+                                  return a->to_string() < b->to_string();
+                                });
+      }
+      for (const auto & v : classes[i]) {
+        if (v != rep) {
+          subst[v] = rep;
+        }
+      }
+    }
+
+    // split classes whose next states differ under that assumption
+    vector<TermVec> new_classes;
+    vector<Term> new_class_vals;
+    vector<bool> new_is_const;
+    for (size_t i = 0; i < classes.size(); ++i) {
+      unordered_map<Term, size_t> sig2class;
+      for (const auto & v : classes[i]) {
+        Term sig = simplify_term(solver_->substitute(updates.at(v), subst));
+        auto it = sig2class.find(sig);
+        if (it == sig2class.end()) {
+          sig2class[sig] = new_classes.size();
+          new_classes.push_back({ v });
+          new_class_vals.push_back(class_vals[i]);
+          new_is_const.push_back(is_const[i] && sig == class_vals[i]);
+        } else {
+          new_classes[it->second].push_back(v);
+        }
+      }
+      changed |= (sig2class.size() > 1);
+      changed |= (new_is_const.back() != is_const[i]);
+    }
+
+    classes = new_classes;
+    class_vals = new_class_vals;
+    is_const = new_is_const;
+  }
+
+  // fixed point: subst is inductive
+  return subst;
+}
+
+size_t TransitionSystemSimplifier::dag_size() const
+{
+  UnorderedTermSet visited;
+  TermVec to_visit({ ts_.init(), ts_.trans() });
+  while (to_visit.size()) {
+    Term t = to_visit.back();
+    to_visit.pop_back();
+    if (visited.insert(t).second) {
+      for (const auto & c : t) {
+        to_visit.push_back(c);
+      }
+    }
+  }
+  return visited.size();
+}
+
+}  // namespace pono
@@ -0,0 +1,100 @@
+/*********************                                                  */
+/*! \file ts_simplifier.h
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Static (i.e., one-time before solving) simplification of a
+**        transition system.
+**
+**        Rewrites init, trans, the state updates and the constraints with
+**        constant folding, slice/concat normalization and a canonical
+**        operand order for commutative operators (so that the solver's
+**        hash-consing identifies structurally equal terms).
+**        For functional systems, it can also merge state variables that
+**        are equivalent (or constant) in every reachable state.
+**
+**/
+
+#pragma once
+
+#include "core/ts.h"
+
+namespace pono {
+
+/** Replace state variables by an equivalent state variable or constant
+ *  and remove them from a functional transition system
+ *  @param ts the transition system to modify
+ *  @param merged map from state variables to their representative
+ *         (a state variable that is not merged, or a value)
+ *  @param terms other terms over ts (e.g. properties), rewritten in place
+ */
+void merge_statevars(TransitionSystem & ts,
+                     const smt::UnorderedTermMap & merged,
+                     smt::TermVec & terms);
+
+class TransitionSystemSimplifier
+{
+ public:
+  /** @param ts the transition system to simplify (in place) */
+  TransitionSystemSimplifier(TransitionSystem & ts);
+
+  /** Simplify the transition system
+   *  @param terms terms over the transition system (e.g. properties)
+   *         these are rewritten in place so that they stay consistent
+   *         with the simplified system
+   *  @param merge if true (and the system is functional)
+   *         also merge equivalent state variables.
+   *         Merged state variables are removed from the system.
+   */
+  void simplify(smt::TermVec & terms, bool merge = true);
+
+  /** @return a simplified term equivalent to t */
+  smt::Term simplify_term(const smt::Term & t);
+
+  /** @return the number of state variables removed by merging */
+  size_t num_merged_statevars() const { return num_merged_; }
+
+ protected:
+  /** Build op(children) where the children are already simplified
+   *  and simplify the top-level node
+   */
+  smt::Term rewrite(const smt::Op & op, smt::TermVec & children);
+
+  /** Constant folding for bit-vectors up to 63 bits
+   *  @return the folded value or nullptr if it does not apply
+   */
+  smt::Term fold_bv(const smt::Op & op, const smt::TermVec & children);
+
+  /** Rewrite all the terms of the transition system with simplify_term */
+  void simplify_ts();
+
+  /** Find state variables that are equivalent to another state variable
+   *  or to a constant in every reachable state
+   *  Greatest fixed point: start with all variables with the same constant
+   *  initial value in one class (optimistically constant) and split classes
+   *  whose updates differ until stable.
+   *  @return map from merged state variables to their representative
+   */
+  smt::UnorderedTermMap find_equivalent_statevars();
+
+  /** @return the number of unique nodes in the terms of the system */
+  size_t dag_size() const;
+
+  TransitionSystem & ts_;
+  smt::SmtSolver solver_;
+
+  smt::UnorderedTermMap cache_;  ///< term -> simplified term
+
+  smt::Term true_;
+  smt::Term false_;
+
+  size_t num_merged_;
+};
+
+}  // namespace pono
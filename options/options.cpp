@@ -15,6 +15,9 @@
  **/
 
 #include "options/options.h"
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -33,6 +36,7 @@ enum optionIndex
   ENGINE,
   BOUND,
   PROP,
+  PROPS,
   VERBOSITY,
   RANDOM_SEED,
   VCDNAME,
@@ -40,7 +44,18 @@ enum optionIndex
   CEGPROPHARR,
   NO_CEGP_AXIOM_RED,
   STATICCOI,
+  SIMPLIFY_TS,
+  MERGE_STATEVARS,
+  ACTIVATION_LITS,
+  BMC_STEP,
+  BMC_EXPONENTIAL,
+  KIND_DUAL_SOLVER,
+  KIND_MINE_INVARIANTS,
+  INTERP_INCREMENTAL,
+  ISB_DUAL,
+  SIM_RUNS,
   CHECK_INVAR,
+  INVAR_CACHE,
   RESET,
   RESET_BND,
   CLK,
@@ -48,11 +63,24 @@ enum optionIndex
   NO_IC3_PREGEN,
   NO_IC3_INDGEN,
   IC3_RESET_INTERVAL,
+  IC3_RESET_DEAD_LEMMAS,
+  IC3_RESET_MEMORY,
+  IC3_RESET_TIME,
+  IC3_LABEL_GC,
+  IC3_NUM_PREDECESSORS,
+  IC3_BATCH_GOALS,
+  IC3_PROPAGATION_THREADS,
   IC3_GEN_MAX_ITER,
   IC3_FUNCTIONAL_PREIMAGE,
+  IC3_TERNARY_SIM,
+  IC3_CHECKPOINT,
   MBIC3_INDGEN_MODE,
+  IC3_CTG_MAX_DEPTH,
+  IC3_CTG_MAX_CTGS,
   PROFILING_LOG_FILENAME,
-  MOD_INIT_PROP
+  MOD_INIT_PROP,
+  PORTFOLIO_ENGINES,
+  PORTFOLIO_SHARE_LEMMAS
 };
 
 struct Arg : public option::Arg
@@ -102,7 +130,7 @@ const option::Descriptor usage[] = {
     "engine",
     Arg::NonEmpty,
     "  --engine, -e <engine> \tSelect engine from [bmc, bmc-sp, ind, "
-    "interp, mbic3, ic3ia, msat-ic3ia]." },
+    "interp, isb, mbic3, ic3ia, msat-ic3ia, portfolio, sim]." },
   { BOUND,
     0,
     "k",
@@ -115,6 +143,14 @@ const option::Descriptor usage[] = {
     "prop",
     Arg::Numeric,
     "  --prop, -p \tProperty index to check (default: 0)." },
+  { PROPS,
+    0,
+    "",
+    "props",
+    Arg::NonEmpty,
+    "  --props <indices> \tComma-separated list of property indices (or "
+    "'all') to check together in one bmc or ind session, sharing the "
+    "unrolling. Only supported for BTOR2 files." },
   { VERBOSITY,
     0,
     "v",
@@ -132,7 +168,8 @@ const option::Descriptor usage[] = {
     "",
     "vcd",
     Arg::NonEmpty,
-    "  --vcd \tName of Value Change Dump (VCD) if witness exists." },
+    "  --vcd \tName of Value Change Dump (VCD) if witness exists. With "
+    "--props, one file per property named <name>_b<idx>.vcd." },
   { SMT_SOLVER,
     0,
     "",
@@ -166,6 +203,90 @@ const option::Descriptor usage[] = {
     Arg::None,
     "  --static-coi \tApply static (i.e., one-time before solving) "
     "cone-of-influence analysis." },
+  { SIMPLIFY_TS,
+    0,
+    "",
+    "simplify-ts",
+    Arg::None,
+    "  --simplify-ts \tSimplify the transition system before solving "
+    "(constant folding, slice/concat normalization). Equivalent state "
+    "variables are only merged when no witness is produced (with "
+    "--no-witness, --static-coi or --merge-statevars)." },
+  { MERGE_STATEVARS,
+    0,
+    "",
+    "merge-statevars",
+    Arg::None,
+    "  --merge-statevars \tMerge state variables that are equivalent or "
+    "constant in all reachable states (candidates from random simulation, "
+    "proven with induction). Only for BTOR2 input. Disables witness "
+    "production." },
+  { ACTIVATION_LITS,
+    0,
+    "",
+    "activation-lits",
+    Arg::None,
+    "  --activation-lits \tIn bmc, bmc-sp and ind, guard per-bound queries "
+    "with fresh activation literals and use check-sat-assuming instead of "
+    "push/pop." },
+  { BMC_STEP,
+    0,
+    "",
+    "bmc-step",
+    Arg::Numeric,
+    "  --bmc-step \tNumber of bounds bmc checks with a single query "
+    "(greater than zero). On a counterexample, bmc bisects the window "
+    "to find the shortest one." },
+  { BMC_EXPONENTIAL,
+    0,
+    "",
+    "bmc-exponential",
+    Arg::None,
+    "  --bmc-exponential \tIn bmc, double the number of bounds checked "
+    "per query (1, 2, 4, ...) until a counterexample is found, then bisect "
+    "to find the shortest one." },
+  { KIND_DUAL_SOLVER,
+    0,
+    "",
+    "kind-dual-solver",
+    Arg::None,
+    "  --kind-dual-solver \tRun the base case and the inductive step of ind "
+    "on separate solvers and threads, so the inductive step can run ahead "
+    "to larger bounds." },
+  { KIND_MINE_INVARIANTS,
+    0,
+    "",
+    "kind-mine-invariants",
+    Arg::None,
+    "  --kind-mine-invariants \tGuess invariants from random simulation "
+    "(constants, equalities, bounds and one-hot state variables), prove "
+    "the largest inductive subset and assert it at every time step. "
+    "Mining starts with ind and is repeated with longer simulation runs "
+    "whenever the bound doubles (from 8 on)." },
+  { INTERP_INCREMENTAL,
+    0,
+    "",
+    "interp-incremental",
+    Arg::None,
+    "  --interp-incremental \tIn interp, build the interpolation queries "
+    "incrementally: the B side is extended once per bound and only the "
+    "new reachable states are added to the A side in each fixpoint "
+    "iteration." },
+  { ISB_DUAL,
+    0,
+    "",
+    "isb-dual",
+    Arg::None,
+    "  --isb-dual \tIn isb, also keep over-approximations of the states "
+    "that can reach a bad state and check them for a fixpoint "
+    "(dual approximated reachability)." },
+  { SIM_RUNS,
+    0,
+    "",
+    "sim-runs",
+    Arg::Numeric,
+    "  --sim-runs \tNumber of random simulation runs of the sim engine, "
+    "each simulating 64 stimuli up to the bound (default: 1024)." },
   { CHECK_INVAR,
     0,
     "",
@@ -173,6 +294,15 @@ const option::Descriptor usage[] = {
     Arg::None,
     "  --check-invar \tFor engines that produce invariants, check that they "
     "hold." },
+  { INVAR_CACHE,
+    0,
+    "",
+    "invar-cache",
+    Arg::NonEmpty,
+    "  --invar-cache <dir> \tBefore running the engine, try to prove the "
+    "property with the largest still inductive part of the invariant cached "
+    "for this design and property in this directory. Invariants of engines "
+    "that produce them are stored there." },
   { RESET,
     0,
     "r",
@@ -219,6 +349,62 @@ const option::Descriptor usage[] = {
     "Note: some solvers don't support resetting assertions, in which "
     "case it will just fail to reset and not try again. This will be "
     "printed at verbosity 1." },
+  { IC3_RESET_DEAD_LEMMAS,
+    0,
+    "",
+    "ic3-reset-dead-lemmas",
+    Arg::Numeric,
+    "  --ic3-reset-dead-lemmas \tReset the solver when more than this "
+    "percentage of the lemmas asserted since the last reset were subsumed "
+    "or pushed to a higher frame (default: 0, i.e. disabled)." },
+  { IC3_RESET_MEMORY,
+    0,
+    "",
+    "ic3-reset-memory",
+    Arg::Numeric,
+    "  --ic3-reset-memory \tReset the solver when the resident memory "
+    "grew by more than this many MB since the last reset "
+    "(default: disabled; Linux only)." },
+  { IC3_RESET_TIME,
+    0,
+    "",
+    "ic3-reset-time",
+    Arg::Numeric,
+    "  --ic3-reset-time \tReset the solver when this many seconds passed "
+    "since the last reset (default: disabled)." },
+  { IC3_LABEL_GC,
+    0,
+    "",
+    "ic3-label-gc",
+    Arg::Numeric,
+    "  --ic3-label-gc \tNumber of new activation literals for unsat cores "
+    "in ic3 generalization before the ones no query uses are disabled "
+    "and forgotten. Solver resets also drop them "
+    "(default: 0, means only on resets)." },
+  { IC3_NUM_PREDECESSORS,
+    0,
+    "",
+    "ic3-num-predecessors",
+    Arg::Numeric,
+    "  --ic3-num-predecessors \tNumber of generalizations (with different "
+    "literal orders) of each predecessor found by ic3, distinct ones are "
+    "all added as proof goals (default: 1)." },
+  { IC3_BATCH_GOALS,
+    0,
+    "",
+    "ic3-batch-goals",
+    Arg::Numeric,
+    "  --ic3-batch-goals \tMaximum number of proof goals of the same frame "
+    "that ic3 checks for predecessors with a single query (default: 1, "
+    "i.e. no batching)." },
+  { IC3_PROPAGATION_THREADS,
+    0,
+    "",
+    "ic3-propagation-threads",
+    Arg::Numeric,
+    "  --ic3-propagation-threads \tNumber of worker solvers that check "
+    "the clauses of a frame concurrently during propagation in ic3 "
+    "(default: sequential propagation on the main solver)." },
   { IC3_GEN_MAX_ITER,
     0,
     "",
@@ -233,6 +419,24 @@ const option::Descriptor usage[] = {
     "ic3-functional-preimage",
     Arg::None,
     "  --ic3-functional-preimage \tUse functional preimage in ic3." },
+  { IC3_TERNARY_SIM,
+    0,
+    "",
+    "ic3-ternary-sim",
+    Arg::None,
+    "  --ic3-ternary-sim \tGeneralize predecessors in IC3 and mbic3 with "
+    "ternary simulation of the state updates before falling back to the "
+    "solver (requires a functional transition system without "
+    "constraints)." },
+  { IC3_CHECKPOINT,
+    0,
+    "",
+    "ic3-checkpoint",
+    Arg::NonEmpty,
+    "  --ic3-checkpoint <file> \tLoad the lemmas of a previous ic3 run from "
+    "this file (if it exists) and save the frames to it after every "
+    "propagation phase and on SIGTERM. Lemmas that are not valid for the "
+    "current system are dropped." },
   { MBIC3_INDGEN_MODE,
     0,
     "",
@@ -240,7 +444,24 @@ const option::Descriptor usage[] = {
     Arg::Numeric,
     "  --mbic3-indgen-mode \tModelBasedIC3 inductive generalization mode "
     "[0,2].\n\t"
-    "0 - normal, 1 - embedded init constraint, 2 - interpolation." },
+    "0 - normal, 1 - embedded init constraint, 2 - interpolation.\n\t"
+    "For Boolean IC3: 0 - literal dropping, 1 - down, "
+    "2 - down with counterexamples to generalization (CTG)." },
+  { IC3_CTG_MAX_DEPTH,
+    0,
+    "",
+    "ic3-ctg-max-depth",
+    Arg::Numeric,
+    "  --ic3-ctg-max-depth \tMaximum recursion depth when generalizing "
+    "counterexamples to generalization in Boolean IC3 (default: 1)." },
+  { IC3_CTG_MAX_CTGS,
+    0,
+    "",
+    "ic3-ctg-max-ctgs",
+    Arg::Numeric,
+    "  --ic3-ctg-max-ctgs \tMaximum number of counterexamples to "
+    "generalization blocked in a row before giving up on dropping a "
+    "literal in Boolean IC3 (default: 3)." },
   { PROFILING_LOG_FILENAME,
     0,
     "",
@@ -255,6 +476,22 @@ const option::Descriptor usage[] = {
     Arg::None,
     "  --mod-init-prop \tReplace init and prop with state variables -- can "
     "extend trace by up to two steps. Recommended for use with ic3ia." },
+  { PORTFOLIO_ENGINES,
+    0,
+    "",
+    "portfolio-engines",
+    Arg::NonEmpty,
+    "  --portfolio-engines <engines> \tComma-separated list of engines raced "
+    "on separate threads by the portfolio engine (default: bmc,ind,mbic3 "
+    "plus interp,ic3ia when built with MathSAT). msat-ic3ia can't be "
+    "cancelled and is not supported." },
+  { PORTFOLIO_SHARE_LEMMAS,
+    0,
+    "",
+    "portfolio-share-lemmas",
+    Arg::None,
+    "  --portfolio-share-lemmas \tShare lemmas learned by IC3 engines in "
+    "the portfolio with the other IC3 and k-induction engines." },
   { 0, 0, 0, 0, 0, 0 }
 };
 /*********************************** end Option Handling setup
@@ -263,7 +500,32 @@ const option::Descriptor usage[] = {
 namespace pono {
 
 const std::string PonoOptions::default_smt_solver_ = "btor";
+const std::string PonoOptions::default_invar_cache_ = "";
+const std::string PonoOptions::default_ic3_checkpoint_ = "";
 const std::string PonoOptions::default_profiling_log_filename_ = "";
+const std::vector<Engine> PonoOptions::default_portfolio_engines_ = {
+  BMC,
+  KIND,
+  MBIC3,
+#ifdef WITH_MSAT
+  INTERP,
+  IC3IA_ENGINE,
+#endif
+};
+
+// Parses the (numeric) argument of option 'name' and throws
+// if it is not in 1..max
+static int parse_positive(const char * arg, const string & name, int max)
+{
+  char * endptr = 0;
+  errno = 0;
+  long val = strtol(arg, &endptr, 10);
+  if (errno || endptr == arg || *endptr != 0 || val < 1 || val > max) {
+    throw PonoException(name + " value must be between 1 and "
+                        + std::to_string(max) + ".");
+  }
+  return val;
+}
 
 Engine PonoOptions::to_engine(std::string s)
 {
@@ -320,6 +582,30 @@ ProverResult PonoOptions::parse_and_set_options(int argc, char ** argv)
         case ENGINE: engine_ = to_engine(opt.arg); break;
         case BOUND: bound_ = atoi(opt.arg); break;
         case PROP: prop_idx_ = atoi(opt.arg); break;
+        case PROPS: {
+          string props = opt.arg;
+          if (props == "all") {
+            all_props_ = true;
+            break;
+          }
+          size_t start = 0;
+          while (start <= props.size()) {
+            size_t end = props.find(',', start);
+            if (end == string::npos) {
+              end = props.size();
+            }
+            string idx = props.substr(start, end - start);
+            if (idx.empty()
+                || idx.find_first_not_of("0123456789") != string::npos) {
+              throw PonoException(
+                  "Option '--props' expects 'all' or a comma-separated list "
+                  "of property indices.");
+            }
+            prop_idxs_.push_back(stoul(idx));
+            start = end + 1;
+          }
+          break;
+        }
         case VERBOSITY: verbosity_ = atoi(opt.arg); break;
         case RANDOM_SEED: random_seed_ = atoi(opt.arg); break;
         case VCDNAME:
@@ -346,13 +632,63 @@ ProverResult PonoOptions::parse_and_set_options(int argc, char ** argv)
         case CEGPROPHARR: ceg_prophecy_arrays_ = true; break;
         case NO_CEGP_AXIOM_RED: cegp_axiom_red_ = false; break;
         case STATICCOI: static_coi_ = true; break;
+        case SIMPLIFY_TS: simplify_ts_ = true; break;
+        case MERGE_STATEVARS: merge_statevars_ = true; break;
+        case ACTIVATION_LITS: activation_lits_ = true; break;
+        case BMC_STEP:
+          // the step is used as an int window in bmc
+          bmc_step_ = parse_positive(opt.arg, "--bmc-step", INT_MAX);
+          break;
+        case BMC_EXPONENTIAL: bmc_exponential_ = true; break;
+        case KIND_DUAL_SOLVER: kind_dual_solver_ = true; break;
+        case KIND_MINE_INVARIANTS: kind_mine_invariants_ = true; break;
+        case INTERP_INCREMENTAL: interp_incremental_ = true; break;
+        case ISB_DUAL: isb_dual_ = true; break;
+        case SIM_RUNS:
+          sim_runs_ = parse_positive(opt.arg, "--sim-runs", INT_MAX);
+          break;
         case CHECK_INVAR: check_invar_ = true; break;
+        case INVAR_CACHE: invar_cache_ = opt.arg; break;
         case RESET: reset_name_ = opt.arg; break;
         case RESET_BND: reset_bnd_ = atoi(opt.arg); break;
         case CLK: clock_name_ = opt.arg; break;
         case NO_IC3_PREGEN: ic3_pregen_ = false; break;
         case NO_IC3_INDGEN: ic3_indgen_ = false; break;
         case IC3_RESET_INTERVAL: ic3_reset_interval_ = atoi(opt.arg); break;
+        case IC3_RESET_DEAD_LEMMAS:
+          ic3_reset_dead_lemmas_ = atoi(opt.arg);
+          if (ic3_reset_dead_lemmas_ > 100) {
+            throw PonoException(
+                "--ic3-reset-dead-lemmas value must be at most 100.");
+          }
+          break;
+        case IC3_RESET_MEMORY:
+          ic3_reset_memory_ =
+              parse_positive(opt.arg, "--ic3-reset-memory", INT_MAX);
+          break;
+        case IC3_RESET_TIME:
+          ic3_reset_time_ =
+              parse_positive(opt.arg, "--ic3-reset-time", INT_MAX);
+          break;
+        case IC3_LABEL_GC: ic3_label_gc_ = atoi(opt.arg); break;
+        case IC3_NUM_PREDECESSORS:
+          ic3_num_predecessors_ = atoi(opt.arg);
+          if (ic3_num_predecessors_ == 0) {
+            throw PonoException(
+                "--ic3-num-predecessors value must be greater than 0.");
+          }
+          break;
+        case IC3_BATCH_GOALS:
+          ic3_batch_goals_ = atoi(opt.arg);
+          if (ic3_batch_goals_ == 0) {
+            throw PonoException(
+                "--ic3-batch-goals value must be greater than 0.");
+          }
+          break;
+        case IC3_PROPAGATION_THREADS:
+          ic3_propagation_threads_ =
+              parse_positive(opt.arg, "--ic3-propagation-threads", INT_MAX);
+          break;
         case IC3_GEN_MAX_ITER: ic3_gen_max_iter_ = atoi(opt.arg); break;
         case MBIC3_INDGEN_MODE:
           mbic3_indgen_mode = atoi(opt.arg);
@@ -360,7 +696,17 @@ ProverResult PonoOptions::parse_and_set_options(int argc, char ** argv)
             throw PonoException(
                 "--ic3-indgen-mode value must be between 0 and 2.");
           break;
+        case IC3_CTG_MAX_DEPTH:
+          ic3_ctg_max_depth_ =
+              parse_positive(opt.arg, "--ic3-ctg-max-depth", INT_MAX);
+          break;
+        case IC3_CTG_MAX_CTGS:
+          ic3_ctg_max_ctgs_ =
+              parse_positive(opt.arg, "--ic3-ctg-max-ctgs", INT_MAX);
+          break;
         case IC3_FUNCTIONAL_PREIMAGE: ic3_functional_preimage_ = true; break;
+        case IC3_TERNARY_SIM: ic3_ternary_sim_ = true; break;
+        case IC3_CHECKPOINT: ic3_checkpoint_ = opt.arg; break;
         case PROFILING_LOG_FILENAME:
 #ifndef WITH_PROFILING
           throw PonoException(
@@ -370,7 +716,31 @@ ProverResult PonoOptions::parse_and_set_options(int argc, char ** argv)
           profiling_log_filename_ = opt.arg;
 #endif
           break;
-        case MOD_INIT_PROP: mod_init_prop_ = true;
+        case MOD_INIT_PROP: mod_init_prop_ = true; break;
+        case PORTFOLIO_ENGINES: {
+          portfolio_engines_.clear();
+          string engines = opt.arg;
+          size_t start = 0;
+          while (start <= engines.size()) {
+            size_t end = engines.find(',', start);
+            if (end == string::npos) {
+              end = engines.size();
+            }
+            Engine e = to_engine(engines.substr(start, end - start));
+            if (e == PORTFOLIO) {
+              throw PonoException(
+                  "Option '--portfolio-engines' cannot contain portfolio.");
+            } else if (e == MSAT_IC3IA) {
+              // it only supports prove, which can't be cancelled
+              throw PonoException(
+                  "Option '--portfolio-engines' cannot contain msat-ic3ia.");
+            }
+            portfolio_engines_.push_back(e);
+            start = end + 1;
+          }
+          break;
+        }
+        case PORTFOLIO_SHARE_LEMMAS: portfolio_share_lemmas_ = true; break;
         case UNKNOWN_OPTION:
           // not possible because Arg::Unknown returns ARG_ILLEGAL
           // which aborts the parse with an error
@@ -378,6 +748,23 @@ ProverResult PonoOptions::parse_and_set_options(int argc, char ** argv)
       }
     }
 
+    if (all_props_ || prop_idxs_.size()) {
+      if (engine_ != Engine::BMC && engine_ != Engine::KIND) {
+        throw PonoException(
+            "Option '--props' only supports the bmc and ind engines.");
+      }
+      if (mod_init_prop_ || ceg_prophecy_arrays_) {
+        throw PonoException(
+            "Option '--props' is incompatible with '--mod-init-prop' and "
+            "'--ceg-prophecy-arrays'.");
+      }
+    }
+
+    if (bmc_exponential_ && bmc_step_ != default_bmc_step_) {
+      throw PonoException(
+          "Options '--bmc-step' and '--bmc-exponential' are incompatible.");
+    }
+
     if (smt_solver_ != "msat" && engine_ == Engine::INTERP) {
       throw PonoException(
           "Interpolation engine can be only used with '--smt-solver msat'.");
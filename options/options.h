@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <string>
 #include <unordered_map>
+#include <vector>
 #include "core/proverresult.h"
 
 namespace pono {
@@ -29,10 +31,13 @@ enum Engine
   BMC_SP,
   KIND,
   INTERP,
+  ISB,
   IC3_BOOL,
   MBIC3,
   IC3IA_ENGINE,
-  MSAT_IC3IA
+  MSAT_IC3IA,
+  PORTFOLIO,
+  SIM
 };
 
 const std::unordered_map<std::string, Engine> str2engine(
@@ -40,9 +45,12 @@ const std::unordered_map<std::string, Engine> str2engine(
       { "bmc-sp", BMC_SP },
       { "ind", KIND },
       { "interp", INTERP },
+      { "isb", ISB },
       { "mbic3", MBIC3 },
       { "ic3ia", IC3IA_ENGINE },
-      { "msat-ic3ia", MSAT_IC3IA } });
+      { "msat-ic3ia", MSAT_IC3IA },
+      { "portfolio", PORTFOLIO },
+      { "sim", SIM } });
 
 /*************************************** Options class
  * ************************************************/
@@ -57,6 +65,7 @@ class PonoOptions
   PonoOptions()
       : engine_(default_engine_),
         prop_idx_(default_prop_idx_),
+        all_props_(default_all_props_),
         bound_(default_bound_),
         verbosity_(default_verbosity_),
         no_witness_(default_no_witness_),
@@ -64,17 +73,41 @@ class PonoOptions
         random_seed_(default_random_seed),
         smt_solver_(default_smt_solver_),
         static_coi_(default_static_coi_),
+        simplify_ts_(default_simplify_ts_),
+        merge_statevars_(default_merge_statevars_),
+        activation_lits_(default_activation_lits_),
+        bmc_step_(default_bmc_step_),
+        bmc_exponential_(default_bmc_exponential_),
+        kind_dual_solver_(default_kind_dual_solver_),
+        kind_mine_invariants_(default_kind_mine_invariants_),
+        interp_incremental_(default_interp_incremental_),
+        isb_dual_(default_isb_dual_),
+        sim_runs_(default_sim_runs_),
         check_invar_(default_check_invar_),
+        invar_cache_(default_invar_cache_),
         ic3_pregen_(default_ic3_pregen_),
         ic3_indgen_(default_ic3_indgen_),
         ic3_gen_max_iter_(default_ic3_gen_max_iter_),
         ic3_reset_interval_(default_ic3_reset_interval_),
+        ic3_reset_dead_lemmas_(default_ic3_reset_dead_lemmas_),
+        ic3_reset_memory_(default_ic3_reset_memory_),
+        ic3_reset_time_(default_ic3_reset_time_),
+        ic3_label_gc_(default_ic3_label_gc_),
+        ic3_num_predecessors_(default_ic3_num_predecessors_),
+        ic3_batch_goals_(default_ic3_batch_goals_),
+        ic3_propagation_threads_(default_ic3_propagation_threads_),
         mbic3_indgen_mode(default_mbic3_indgen_mode),
+        ic3_ctg_max_depth_(default_ic3_ctg_max_depth_),
+        ic3_ctg_max_ctgs_(default_ic3_ctg_max_ctgs_),
         ic3_functional_preimage_(default_ic3_functional_preimage_),
+        ic3_ternary_sim_(default_ic3_ternary_sim_),
+        ic3_checkpoint_(default_ic3_checkpoint_),
         ceg_prophecy_arrays_(default_ceg_prophecy_arrays_),
         cegp_axiom_red_(default_cegp_axiom_red_),
         profiling_log_filename_(default_profiling_log_filename_),
-        mod_init_prop_(default_mod_init_prop_)
+        mod_init_prop_(default_mod_init_prop_),
+        portfolio_engines_(default_portfolio_engines_),
+        portfolio_share_lemmas_(default_portfolio_share_lemmas_)
   {
   }
 
@@ -87,6 +120,8 @@ class PonoOptions
   // Pono options
   Engine engine_;
   unsigned int prop_idx_;
+  std::vector<unsigned int> prop_idxs_;  ///< properties checked together
+  bool all_props_;  ///< check all properties together
   unsigned int bound_;
   unsigned int verbosity_;
   unsigned int random_seed_;
@@ -98,44 +133,100 @@ class PonoOptions
   std::string filename_;
   std::string smt_solver_; ///< underlying smt solver
   bool static_coi_;
+  bool simplify_ts_;  ///< simplify the transition system before solving
+  bool merge_statevars_;  ///< merge equivalent state variables before solving
+  bool activation_lits_;  ///< use activation literals instead of push/pop
+                          ///< in bmc, bmc-sp and ind
+  unsigned int bmc_step_;  ///< number of bounds per bmc query
+  bool bmc_exponential_;   ///< double the bounds per bmc query each time
+  bool kind_dual_solver_;  ///< base case and inductive step on two threads
+  bool kind_mine_invariants_;  ///< strengthen ind with mined invariants
+  bool interp_incremental_;  ///< incremental interpolation queries in interp
+  bool isb_dual_;  ///< also keep backward frames in isb
+  unsigned int sim_runs_;  ///< number of runs of the sim engine
   bool check_invar_;  ///< check invariants (if available) when run through CLI
+  std::string invar_cache_;  ///< directory of cached invariants, "": none
   // ic3 options
   bool ic3_pregen_;  ///< generalize counterexamples in IC3
   bool ic3_indgen_;  ///< inductive generalization in IC3
   unsigned int ic3_reset_interval_;  ///< number of check sat calls before
                                      ///< resetting. 0 means unbounded
+  unsigned int ic3_reset_dead_lemmas_;  ///< percentage of lemmas in the
+                                        ///< solver that are no longer in a
+                                        ///< frame before resetting, 0: off
+  unsigned int ic3_reset_memory_;  ///< MB of memory growth before resetting
+                                   ///< 0 means unbounded
+  unsigned int ic3_reset_time_;  ///< seconds before resetting, 0: unbounded
+  unsigned int ic3_label_gc_;  ///< new unsat core labels between collections
+                               ///< the unused ones, 0: never
+  unsigned int ic3_num_predecessors_;  ///< generalized predecessors per model
+  unsigned int ic3_batch_goals_;  ///< max proof goals checked together
+  unsigned int ic3_propagation_threads_;  ///< worker solvers for propagation
+                                          ///< 0 or 1 means sequential
   unsigned int ic3_gen_max_iter_; ///< max iterations in ic3 generalization. 0
                                   ///means unbounded
   unsigned int mbic3_indgen_mode;  ///< inductive generalization mode [0,2]
+  unsigned int ic3_ctg_max_depth_;  ///< max recursion depth of CTG blocking
+  unsigned int ic3_ctg_max_ctgs_;   ///< max CTGs blocked per literal drop
   bool ic3_functional_preimage_; ///< functional preimage in IC3
+  bool ic3_ternary_sim_;  ///< ternary simulation for predecessors in IC3
+  std::string ic3_checkpoint_;  ///< file to save/load IC3 frames, "": none
   // ceg-prophecy-arrays options
   bool ceg_prophecy_arrays_;
   bool cegp_axiom_red_;  ///< reduce axioms with an unsat core in ceg prophecy
   std::string profiling_log_filename_;
   bool mod_init_prop_;  ///< replace init and prop with boolean state vars
+  // portfolio options
+  std::vector<Engine> portfolio_engines_;  ///< engines raced by portfolio
+  bool portfolio_share_lemmas_;  ///< exchange lemmas between portfolio engines
 
  private:
   // Default options
   static const Engine default_engine_ = BMC;
   static const unsigned int default_prop_idx_ = 0;
+  static const bool default_all_props_ = false;
   static const unsigned int default_bound_ = 10;
   static const unsigned int default_verbosity_ = 0;
   static const unsigned int default_random_seed = 0;
   static const bool default_no_witness_ = false;
   static const bool default_ceg_prophecy_arrays_ = false;
   static const bool default_static_coi_ = false;
+  static const bool default_simplify_ts_ = false;
+  static const bool default_merge_statevars_ = false;
+  static const bool default_activation_lits_ = false;
+  static const unsigned int default_bmc_step_ = 1;
+  static const bool default_bmc_exponential_ = false;
+  static const bool default_kind_dual_solver_ = false;
+  static const bool default_kind_mine_invariants_ = false;
+  static const bool default_interp_incremental_ = false;
+  static const bool default_isb_dual_ = false;
+  static const unsigned int default_sim_runs_ = 1024;
   static const bool default_check_invar_ = false;
+  static const std::string default_invar_cache_;
   static const size_t default_reset_bnd_ = 1;
   static const std::string default_smt_solver_;
   static const bool default_ic3_pregen_ = true;
   static const bool default_ic3_indgen_ = true;
   static const unsigned int default_ic3_reset_interval_ = 5000;
+  static const unsigned int default_ic3_reset_dead_lemmas_ = 0;
+  static const unsigned int default_ic3_reset_memory_ = 0;
+  static const unsigned int default_ic3_reset_time_ = 0;
+  static const unsigned int default_ic3_label_gc_ = 0;
+  static const unsigned int default_ic3_num_predecessors_ = 1;
+  static const unsigned int default_ic3_batch_goals_ = 1;
+  static const unsigned int default_ic3_propagation_threads_ = 0;
   static const unsigned int default_ic3_gen_max_iter_ = 2;
   static const unsigned int default_mbic3_indgen_mode = 0;
+  static const unsigned int default_ic3_ctg_max_depth_ = 1;
+  static const unsigned int default_ic3_ctg_max_ctgs_ = 3;
   static const bool default_ic3_functional_preimage_ = false;
+  static const bool default_ic3_ternary_sim_ = false;
+  static const std::string default_ic3_checkpoint_;
   static const bool default_cegp_axiom_red_ = true;
   static const std::string default_profiling_log_filename_;
   static const bool default_mod_init_prop_ = false;
+  static const std::vector<Engine> default_portfolio_engines_;
+  static const bool default_portfolio_share_lemmas_ = false;
 };
 
 }  // namespace pono
@@ -16,6 +16,7 @@
 
 #include <csignal>
 #include <iostream>
+#include <memory>
 #include "assert.h"
 
 #ifdef WITH_PROFILING
@@ -29,16 +30,20 @@
 
 #include "core/fts.h"
 #include "engines/ceg_prophecy_arrays.h"
+#include "engines/multi_prop.h"
 #include "frontends/btor2_encoder.h"
 #include "frontends/smv_encoder.h"
 #include "modifiers/control_signals.h"
 #include "modifiers/mod_init_prop.h"
 #include "modifiers/prop_monitor.h"
+#include "modifiers/state_var_merger.h"
 #include "modifiers/static_coi.h"
+#include "modifiers/ts_simplifier.h"
 #include "options/options.h"
 #include "printers/btor2_witness_printer.h"
 #include "printers/vcd_witness_printer.h"
 #include "prop.h"
+#include "utils/invariant_cache.h"
 #include "utils/logger.h"
 #include "utils/make_provers.h"
 #include "utils/ts_analysis.h"
@@ -51,6 +56,64 @@ using namespace smt;
 using namespace std;
 
 
+// Checks the invariant of a property the prover proved (with --check-invar)
+// Returns UNKNOWN if the invariant check fails, TRUE otherwise
+ProverResult report_invar(const PonoOptions & pono_options,
+                          Prover & prover,
+                          const Property & p,
+                          const TransitionSystem & ts)
+{
+  ProverResult r = ProverResult::TRUE;
+  if (!pono_options.check_invar_) {
+    return r;
+  }
+
+  try {
+    Term invar = prover.invar();
+    bool invar_passes = check_invar(ts, p.prop(), invar);
+    std::cout << "Invariant Check " << (invar_passes ? "PASSED" : "FAILED")
+              << std::endl;
+    if (!invar_passes) {
+      // shouldn't return true if invariant is incorrect
+      r = ProverResult::UNKNOWN;
+    }
+  }
+  catch (PonoException & e) {
+    std::cout << "Engine " << pono_options.engine_
+              << " does not support getting the invariant." << std::endl;
+  }
+  return r;
+}
+
+// Prints the btor result for property prop_idx
+// and the witness (if any) in btor format and to vcd_name (if not empty)
+void print_btor_result(ProverResult r,
+                       unsigned int prop_idx,
+                       const vector<UnorderedTermMap> & cex,
+                       const TransitionSystem & ts,
+                       const BTOR2Encoder & btor_enc,
+                       const string & vcd_name)
+{
+  if (r == FALSE) {
+    cout << "sat" << endl;
+    cout << "b" << prop_idx << endl;
+    if (cex.size()) {
+      print_witness_btor(btor_enc, cex);
+      if (!vcd_name.empty()) {
+        VCDWitnessPrinter vcdprinter(ts, cex);
+        vcdprinter.dump_trace_to_file(vcd_name);
+      }
+    }
+  } else if (r == TRUE) {
+    cout << "unsat" << endl;
+    cout << "b" << prop_idx << endl;
+  } else {
+    assert(r == pono::UNKNOWN);
+    cout << "unknown" << endl;
+    cout << "b" << prop_idx << endl;
+  }
+}
+
 ProverResult check_prop(PonoOptions pono_options,
                         Property & p,
                         const TransitionSystem & ts,
@@ -65,6 +128,31 @@ ProverResult check_prop(PonoOptions pono_options,
 
   Engine eng = pono_options.engine_;
 
+  std::unique_ptr<InvariantCache> invar_cache;
+  if (!pono_options.invar_cache_.empty()) {
+    invar_cache.reset(new InvariantCache(
+        pono_options.invar_cache_, pono_options.filename_, p.name()));
+    Term invar = invar_cache->prove(ts, p.prop());
+    if (invar) {
+      logger.log(1, "Proved the property with the cached invariant");
+      if (pono_options.check_invar_) {
+        if (check_invar(ts, p.prop(), invar)) {
+          std::cout << "Invariant Check PASSED" << std::endl;
+        } else {
+          // the engine's result is reported instead
+          logger.log(0,
+                     "Cached invariant failed the check, running the engine");
+          invar = nullptr;
+        }
+      }
+    }
+    if (invar) {
+      // keep only the part that is still inductive
+      invar_cache->store(invar);
+      return ProverResult::TRUE;
+    }
+  }
+
   std::shared_ptr<Prover> prover;
   if (pono_options.ceg_prophecy_arrays_) {
     // don't instantiate the sub-prover directly
@@ -101,20 +189,16 @@ ProverResult check_prop(PonoOptions pono_options,
           0,
           "Only got a partial witness from engine. Not suitable for printing.");
     }
-  } else if (r == TRUE && pono_options.check_invar_) {
-    try {
-      Term invar = prover->invar();
-      bool invar_passes = check_invar(ts, p.prop(), invar);
-      std::cout << "Invariant Check " << (invar_passes ? "PASSED" : "FAILED")
-                << std::endl;
-      if (!invar_passes) {
-        // shouldn't return true if invariant is incorrect
-        r = ProverResult::UNKNOWN;
+  } else if (r == TRUE) {
+    r = report_invar(pono_options, *prover, p, ts);
+    // cached invariants are checked again when they are used
+    if (invar_cache && r == TRUE) {
+      try {
+        invar_cache->store(prover->invar());
+      }
+      catch (PonoException & e) {
+        logger.log(1, "Not caching the invariant: {}", e.what());
       }
-    }
-    catch (PonoException & e) {
-      std::cout << "Engine " << pono_options.engine_
-                << " does not support getting the invariant." << std::endl;
     }
   }
   return r;
@@ -217,6 +301,14 @@ int main(int argc, char ** argv)
       s->set_opt("incremental", "true");
     }
 
+    if (pono_options.merge_statevars_ && !pono_options.no_witness_) {
+      logger.log(
+          0,
+          "Warning: disabling witness production. Temporary restriction -- "
+          "Cannot produce witness with option --merge-statevars");
+      pono_options.no_witness_ = true;
+    }
+
     // limitations with COI
     if (pono_options.static_coi_) {
       if (!pono_options.no_witness_) {
@@ -248,16 +340,33 @@ int main(int argc, char ** argv)
       BTOR2Encoder btor_enc(pono_options.filename_, fts);
       const TermVec & propvec = btor_enc.propvec();
       unsigned int num_props = propvec.size();
-      if (pono_options.prop_idx_ >= num_props) {
-        throw PonoException(
-            "Property index " + to_string(pono_options.prop_idx_)
-            + " is greater than the number of properties in file "
-            + pono_options.filename_ + " (" + to_string(num_props) + ")");
+
+      bool multi_prop =
+          pono_options.all_props_ || pono_options.prop_idxs_.size();
+      vector<unsigned int> prop_idxs;
+      if (pono_options.all_props_) {
+        for (unsigned int i = 0; i < num_props; ++i) {
+          prop_idxs.push_back(i);
+        }
+      } else if (multi_prop) {
+        prop_idxs = pono_options.prop_idxs_;
+      } else {
+        prop_idxs.push_back(pono_options.prop_idx_);
       }
 
-      Term prop = propvec[pono_options.prop_idx_];
-      // get property name before it is rewritten
-      const string prop_name = fts.get_name(prop);
+      TermVec props;
+      vector<string> prop_names;
+      for (auto idx : prop_idxs) {
+        if (idx >= num_props) {
+          throw PonoException(
+              "Property index " + to_string(idx)
+              + " is greater than the number of properties in file "
+              + pono_options.filename_ + " (" + to_string(num_props) + ")");
+        }
+        props.push_back(propvec[idx]);
+        // get property name before it is rewritten
+        prop_names.push_back(fts.get_name(propvec[idx]));
+      }
 
       if (!pono_options.clock_name_.empty()) {
         Term clock_symbol = fts.lookup(pono_options.clock_name_);
@@ -278,52 +387,107 @@ int main(int argc, char ** argv)
         }
         Term reset_done =
             add_reset_seq(fts, reset_symbol, pono_options.reset_bnd_);
-        // guard the property with reset_done
-        prop = fts.solver()->make_term(Implies, reset_done, prop);
+        // guard the properties with reset_done
+        for (auto & prop : props) {
+          prop = fts.solver()->make_term(Implies, reset_done, prop);
+        }
       }
 
       if (pono_options.mod_init_prop_) {
-        prop = modify_init_and_prop(fts, prop);
+        // not supported with multiple properties (checked by options)
+        assert(props.size() == 1);
+        props[0] = modify_init_and_prop(fts, props[0]);
+      }
+
+      if (pono_options.simplify_ts_) {
+        // merged state variables can't be recovered for a witness
+        if (!pono_options.no_witness_) {
+          logger.log(1,
+                     "Not merging state variables in --simplify-ts to keep "
+                     "the witness. Use --no-witness to merge them.");
+        }
+        TransitionSystemSimplifier simplifier(fts);
+        simplifier.simplify(props, pono_options.no_witness_);
+      }
+
+      if (pono_options.merge_statevars_) {
+        StateVarMerger merger(fts, 1, 4, 64, pono_options.random_seed_);
+        merger.merge(props);
       }
 
       if (pono_options.static_coi_) {
         /* Compute the set of state/input variables related to the
-           bad-state property. Based on that information, rebuild the
+           bad-state properties. Based on that information, rebuild the
            transition relation of the transition system. */
-        StaticConeOfInfluence coi(fts, { prop }, pono_options.verbosity_);
+        StaticConeOfInfluence coi(fts, props, pono_options.verbosity_);
       }
 
-      if (!fts.only_curr(prop)) {
-        logger.log(1, "Got next state or input variables in property. "
-                   "Generating a monitor state.");
-        prop = add_prop_monitor(fts, prop);
+      for (auto & prop : props) {
+        if (!fts.only_curr(prop)) {
+          logger.log(1, "Got next state or input variables in property. "
+                     "Generating a monitor state.");
+          prop = add_prop_monitor(fts, prop);
+        }
       }
 
-      vector<UnorderedTermMap> cex;
-      Property p(s, prop, prop_name);
-      res = check_prop(pono_options, p, fts, s, second_solver, cex);
-      // we assume that a prover never returns 'ERROR'
-      assert(res != ERROR);
-
-      // print btor output
-      if (res == FALSE) {
-        cout << "sat" << endl;
-        cout << "b" << pono_options.prop_idx_ << endl;
-        assert(!pono_options.no_witness_ || !cex.size());
-        if (cex.size()) {
-          print_witness_btor(btor_enc, cex);
-          if (!pono_options.vcd_name_.empty()) {
-            VCDWitnessPrinter vcdprinter(fts, cex);
-            vcdprinter.dump_trace_to_file(pono_options.vcd_name_);
+      if (multi_prop) {
+        vector<Property> properties;
+        for (size_t i = 0; i < props.size(); ++i) {
+          properties.push_back(Property(s, props[i], prop_names[i]));
+        }
+        MultiPropProver prover(properties, fts, s, pono_options);
+        res = prover.check_until(pono_options.bound_);
+        assert(res != ERROR);
+
+        // print btor output, one result per property
+        // res is recomputed from the printed results, which are
+        // UNKNOWN instead of TRUE if the invariant check fails
+        bool all_true = true;
+        bool any_false = false;
+        for (size_t i = 0; i < prop_idxs.size(); ++i) {
+          ProverResult r = prover.result(i);
+          vector<UnorderedTermMap> cex;
+          if (r == FALSE && !pono_options.no_witness_) {
+            if (!prover.witness(i, cex)) {
+              logger.log(0,
+                         "Only got a partial witness from engine. Not "
+                         "suitable for printing.");
+            }
+          } else if (r == TRUE) {
+            r = report_invar(pono_options, prover, properties[i], fts);
+          }
+          all_true &= (r == TRUE);
+          any_false |= (r == FALSE);
+
+          // one vcd file per property: <name>_b<idx>.vcd
+          string vcd_name = pono_options.vcd_name_;
+          if (!vcd_name.empty()) {
+            size_t dot = vcd_name.rfind('.');
+            string suffix = "_b" + std::to_string(prop_idxs[i]);
+            if (dot == string::npos || dot == 0) {
+              vcd_name += suffix;
+            } else {
+              vcd_name.insert(dot, suffix);
+            }
           }
+          print_btor_result(r, prop_idxs[i], cex, fts, btor_enc, vcd_name);
         }
-      } else if (res == TRUE) {
-        cout << "unsat" << endl;
-        cout << "b" << pono_options.prop_idx_ << endl;
+        res = any_false ? FALSE : (all_true ? TRUE : UNKNOWN);
       } else {
-        assert(res == pono::UNKNOWN);
-        cout << "unknown" << endl;
-        cout << "b" << pono_options.prop_idx_ << endl;
+        vector<UnorderedTermMap> cex;
+        Property p(s, props[0], prop_names[0]);
+        res = check_prop(pono_options, p, fts, s, second_solver, cex);
+        // we assume that a prover never returns 'ERROR'
+        assert(res != ERROR);
+
+        // print btor output
+        assert(!pono_options.no_witness_ || !cex.size());
+        print_btor_result(res,
+                          pono_options.prop_idx_,
+                          cex,
+                          fts,
+                          btor_enc,
+                          pono_options.vcd_name_);
       }
 
     } else if (file_ext == "smv") {
@@ -359,6 +523,14 @@ int main(int argc, char ** argv)
         prop = modify_init_and_prop(rts, prop);
       }
 
+      if (pono_options.simplify_ts_) {
+        // only functional systems support merging state variables
+        TransitionSystemSimplifier simplifier(rts);
+        TermVec props({ prop });
+        simplifier.simplify(props, false);
+        prop = props[0];
+      }
+
       if (pono_options.static_coi_) {
         // NOTE: currently only supports FunctionalTransitionSystem
         // but let StaticConeOfInfluence throw the exception
@@ -39,4 +39,25 @@ void counter_system(TransitionSystem & ts, const Term & max_val)
   ts.set_init(ts.make_term(Equal, x, zero));
 }
 
+TermVec shift_register(TransitionSystem & ts,
+                       size_t num_bits,
+                       bool safe,
+                       const string & prefix)
+{
+  assert(num_bits);
+  Sort boolsort = ts.make_sort(BOOL);
+  TermVec bits;
+  for (size_t i = 0; i < num_bits; ++i) {
+    string name = prefix + "b" + std::to_string(i);
+    bits.push_back(ts.make_statevar(name, boolsort));
+    ts.constrain_init(ts.make_term(Not, bits.back()));
+  }
+  Term in = ts.make_inputvar(prefix + "in", boolsort);
+  ts.assign_next(bits[0], safe ? ts.make_term(And, bits[0], in) : in);
+  for (size_t i = 1; i < num_bits; ++i) {
+    ts.assign_next(bits[i], bits[i - 1]);
+  }
+  return bits;
+}
+
 }  // namespace pono_tests
@@ -14,6 +14,8 @@
 **
 **/
 
+#include <string>
+
 #include "core/fts.h"
 #include "core/prop.h"
 #include "core/rts.h"
@@ -27,4 +29,19 @@ namespace pono_tests {
  */
 void counter_system(pono::TransitionSystem & ts, const smt::Term & max_val);
 
+/** Creates a shift register of boolean state variables that start at false
+ *  The first bit is set to the input variable <prefix>in, every other bit
+ *  takes the value of the previous one
+ *  @param ts the transition system to add to
+ *  @param num_bits the number of bits, named <prefix>b0, <prefix>b1, ...
+ *  @param safe if true, the first bit can only stay true once it is true
+ *         so the last bit is never true
+ *  @param prefix prefix for the variable names
+ *  @return the bits, in order
+ */
+smt::TermVec shift_register(pono::TransitionSystem & ts,
+                            size_t num_bits,
+                            bool safe,
+                            const std::string & prefix = "");
+
 }  // namespace pono_tests
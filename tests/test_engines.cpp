@@ -7,7 +7,11 @@
 #include "engines/bmc.h"
 #include "engines/bmc_simplepath.h"
 #include "engines/interpolantmc.h"
+#include "engines/interpseqmc.h"
 #include "engines/kinduction.h"
+#include "engines/multi_prop.h"
+#include "engines/portfolio.h"
+#include "engines/random_sim.h"
 #include "gtest/gtest.h"
 #include "smt/available_solvers.h"
 #include "tests/common_ts.h"
@@ -112,6 +116,161 @@ TEST_P(EngineUnitTests, KInductionFalse)
   ASSERT_EQ(r, ProverResult::FALSE);
 }
 
+TEST_P(EngineUnitTests, ActivationLits)
+{
+  PonoOptions opts;
+  opts.activation_lits_ = true;
+
+  SmtSolver s = create_solver(se);
+  Bmc b(*false_p, *ts, s, opts);
+  ASSERT_EQ(b.check_until(20), ProverResult::FALSE);
+
+  s = create_solver(se);
+  BmcSimplePath bsp(*true_p, *ts, s, opts);
+  ASSERT_EQ(bsp.check_until(20), ProverResult::TRUE);
+
+  s = create_solver(se);
+  KInduction kind_true(*true_p, *ts, s, opts);
+  ASSERT_EQ(kind_true.check_until(20), ProverResult::TRUE);
+
+  s = create_solver(se);
+  KInduction kind_false(*false_p, *ts, s, opts);
+  ASSERT_EQ(kind_false.check_until(20), ProverResult::FALSE);
+  vector<UnorderedTermMap> cex;
+  ASSERT_TRUE(kind_false.witness(cex));
+}
+
+TEST_P(EngineUnitTests, BmcStep)
+{
+  PonoOptions opts;
+  opts.bmc_step_ = 3;
+
+  SmtSolver s = create_solver(se);
+  Bmc b_true(*true_p, *ts, s, opts);
+  ASSERT_EQ(b_true.check_until(20), ProverResult::UNKNOWN);
+
+  for (auto act : { false, true }) {
+    opts.activation_lits_ = act;
+    s = create_solver(se);
+    Bmc b(*false_p, *ts, s, opts);
+    ASSERT_EQ(b.check_until(20), ProverResult::FALSE);
+    // bisection finds the shortest counterexample (x reaches 7)
+    vector<UnorderedTermMap> cex;
+    ASSERT_TRUE(b.witness(cex));
+    ASSERT_EQ(cex.size(), 8u);
+  }
+}
+
+TEST_P(EngineUnitTests, BmcExponential)
+{
+  PonoOptions opts;
+  opts.bmc_exponential_ = true;
+
+  SmtSolver s = create_solver(se);
+  Bmc b_true(*true_p, *ts, s, opts);
+  ASSERT_EQ(b_true.check_until(20), ProverResult::UNKNOWN);
+
+  s = create_solver(se);
+  Bmc b(*false_p, *ts, s, opts);
+  ASSERT_EQ(b.check_until(20), ProverResult::FALSE);
+  vector<UnorderedTermMap> cex;
+  ASSERT_TRUE(b.witness(cex));
+  ASSERT_EQ(cex.size(), 8u);
+}
+
+TEST_P(EngineUnitTests, KInductionDualSolver)
+{
+  PonoOptions opts;
+  opts.kind_dual_solver_ = true;
+
+  for (auto act : { false, true }) {
+    opts.activation_lits_ = act;
+    SmtSolver s = create_solver(se);
+    KInduction kind_true(*true_p, *ts, s, opts);
+    ASSERT_EQ(kind_true.check_until(20), ProverResult::TRUE);
+
+    s = create_solver(se);
+    KInduction kind_false(*false_p, *ts, s, opts);
+    ASSERT_EQ(kind_false.check_until(20), ProverResult::FALSE);
+    vector<UnorderedTermMap> cex;
+    ASSERT_TRUE(kind_false.witness(cex));
+    ASSERT_EQ(cex.size(), 8u);
+  }
+}
+
+TEST_P(EngineUnitTests, RandomSimulation)
+{
+  SmtSolver s = create_solver(se);
+  if (!ts->is_functional()) {
+    RandomSimulation sim(*false_p, *ts, s);
+    ASSERT_THROW(sim.check_until(20), PonoException);
+    return;
+  }
+
+  RandomSimulation sim_true(*true_p, *ts, s);
+  ASSERT_EQ(sim_true.check_until(20), ProverResult::UNKNOWN);
+
+  s = create_solver(se);
+  RandomSimulation sim(*false_p, *ts, s);
+  ASSERT_EQ(sim.check_until(20), ProverResult::FALSE);
+  vector<UnorderedTermMap> cex;
+  ASSERT_TRUE(sim.witness(cex));
+  ASSERT_EQ(cex.size(), 8u);
+  Term x = ts->named_terms().at("x");
+  EXPECT_EQ(cex.back().at(x), ts->make_term(7, bvsort8));
+}
+
+TEST_P(EngineUnitTests, MultiPropBmc)
+{
+  SmtSolver s = create_solver(se);
+  PonoOptions opts;
+  opts.engine_ = BMC;
+  MultiPropProver mp({ *true_p, *false_p }, *ts, s, opts);
+  ProverResult r = mp.check_until(20);
+  ASSERT_EQ(r, ProverResult::FALSE);
+  ASSERT_EQ(mp.result(0), ProverResult::UNKNOWN);
+  ASSERT_EQ(mp.result(1), ProverResult::FALSE);
+  vector<UnorderedTermMap> cex;
+  ASSERT_TRUE(mp.witness(1, cex));
+  ASSERT_EQ(cex.size(), (size_t)mp.decided_at(1) + 1);
+}
+
+TEST_P(EngineUnitTests, MultiPropKInduction)
+{
+  SmtSolver s = create_solver(se);
+  PonoOptions opts;
+  opts.engine_ = KIND;
+  MultiPropProver mp({ *true_p, *false_p }, *ts, s, opts);
+  ProverResult r = mp.check_until(20);
+  ASSERT_EQ(r, ProverResult::FALSE);
+  ASSERT_EQ(mp.result(0), ProverResult::TRUE);
+  ASSERT_EQ(mp.result(1), ProverResult::FALSE);
+}
+
+TEST_P(EngineUnitTests, PortfolioTrue)
+{
+  SmtSolver s = create_solver(se);
+  PonoOptions opts;
+  opts.portfolio_engines_ = { BMC, KIND };
+  Portfolio pf(*true_p, *ts, s, opts);
+  ProverResult r = pf.check_until(20);
+  ASSERT_EQ(r, ProverResult::TRUE);
+  ASSERT_EQ(pf.winner(), KIND);
+}
+
+TEST_P(EngineUnitTests, PortfolioFalse)
+{
+  SmtSolver s = create_solver(se);
+  PonoOptions opts;
+  opts.portfolio_engines_ = { BMC, KIND };
+  Portfolio pf(*false_p, *ts, s, opts);
+  ProverResult r = pf.check_until(20);
+  ASSERT_EQ(r, ProverResult::FALSE);
+  vector<UnorderedTermMap> cex;
+  ASSERT_TRUE(pf.witness(cex));
+  ASSERT_GT(cex.size(), 0u);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     ParameterizedEngineUnitTests,
     EngineUnitTests,
@@ -151,6 +310,44 @@ TEST_P(InterpUnitTest, InterpFalse)
   ASSERT_EQ(r, ProverResult::FALSE);
 }
 
+TEST_P(InterpUnitTest, InterpIncremental)
+{
+  PonoOptions opts;
+  opts.interp_incremental_ = true;
+  InterpolantMC itpmc_true(*true_p, *ts, s, itp, opts);
+  ASSERT_EQ(itpmc_true.check_until(20), ProverResult::TRUE);
+  ASSERT_TRUE(check_invar(*ts, true_p->prop(), itpmc_true.invar()));
+
+  SmtSolver s2 = ::smt::MsatSolverFactory::create(false);
+  SmtSolver itp2 = ::smt::MsatSolverFactory::create_interpolating_solver();
+  InterpolantMC itpmc_false(*false_p, *ts, s2, itp2, opts);
+  ASSERT_EQ(itpmc_false.check_until(20), ProverResult::FALSE);
+  vector<UnorderedTermMap> cex;
+  ASSERT_TRUE(itpmc_false.witness(cex));
+  ASSERT_EQ(cex.size(), 8u);
+}
+
+TEST_P(InterpUnitTest, InterpSeq)
+{
+  PonoOptions opts;
+  for (auto dual : { false, true }) {
+    opts.isb_dual_ = dual;
+    SmtSolver s1 = ::smt::MsatSolverFactory::create(false);
+    SmtSolver itp1 = ::smt::MsatSolverFactory::create_interpolating_solver();
+    InterpSeqMC isb_true(*true_p, *ts, s1, itp1, opts);
+    ASSERT_EQ(isb_true.check_until(20), ProverResult::TRUE);
+    ASSERT_TRUE(check_invar(*ts, true_p->prop(), isb_true.invar()));
+
+    SmtSolver s2 = ::smt::MsatSolverFactory::create(false);
+    SmtSolver itp2 = ::smt::MsatSolverFactory::create_interpolating_solver();
+    InterpSeqMC isb_false(*false_p, *ts, s2, itp2, opts);
+    ASSERT_EQ(isb_false.check_until(20), ProverResult::FALSE);
+    vector<UnorderedTermMap> cex;
+    ASSERT_TRUE(isb_false.witness(cex));
+    ASSERT_EQ(cex.size(), 8u);
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     ParameterizedInterpUnitTest,
     InterpUnitTest,
@@ -245,6 +442,13 @@ TEST_P(InterpWinTests, InterpWin)
   ASSERT_EQ(r, ProverResult::TRUE);
 }
 
+TEST_P(InterpWinTests, InterpSeqWin)
+{
+  InterpSeqMC isb(*true_p, *ts, s, itp);
+  ProverResult r = isb.check_until(10);
+  ASSERT_EQ(r, ProverResult::TRUE);
+}
+
 INSTANTIATE_TEST_SUITE_P(ParameterizedInterpWinTests,
                          InterpWinTests,
                          testing::ValuesIn({ Functional, Relational }));
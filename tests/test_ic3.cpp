@@ -1,3 +1,5 @@
+#include <cstdio>
+#include <fstream>
 #include <utility>
 #include <vector>
 
@@ -6,6 +8,7 @@
 #include "engines/ic3.h"
 #include "gtest/gtest.h"
 #include "smt/available_solvers.h"
+#include "tests/common_ts.h"
 #include "utils/ts_analysis.h"
 
 using namespace pono;
@@ -14,6 +17,51 @@ using namespace std;
 
 namespace pono_tests {
 
+/** IC3 with a reset policy that resets before every proof goal */
+class AlwaysResetIC3 : public IC3
+{
+ public:
+  AlwaysResetIC3(const Property & p,
+                 const TransitionSystem & ts,
+                 const SmtSolver & s,
+                 PonoOptions opt = PonoOptions())
+      : IC3(p, ts, s, opt), num_resets(0)
+  {
+  }
+
+  size_t num_resets;
+
+ protected:
+  bool should_reset_solver() override
+  {
+    num_resets++;
+    return true;
+  }
+};
+
+/** IC3 with the frames, propagation and labels exposed */
+class IC3Internals : public IC3
+{
+ public:
+  IC3Internals(const Property & p,
+               const TransitionSystem & ts,
+               const SmtSolver & s,
+               PonoOptions opt = PonoOptions())
+      : IC3(p, ts, s, opt)
+  {
+  }
+
+  using IC3Base::collect_labels;
+  using IC3Base::constrain_frame;
+  using IC3Base::frames_;
+  using IC3Base::label;
+  using IC3Base::labels_;
+  using IC3Base::prop_workers_;
+  using IC3Base::propagate;
+  using IC3Base::push_frame;
+  using IC3Base::release_labels;
+};
+
 class IC3UnitTests : public ::testing::Test,
                      public ::testing::WithParamInterface<SolverEnum>
 {
@@ -30,28 +78,278 @@ class IC3UnitTests : public ::testing::Test,
 
 TEST_P(IC3UnitTests, SimpleSystemSafe)
 {
-  RelationalTransitionSystem rts(s);
-  Term s1 = rts.make_statevar("s1", boolsort);
-  Term s2 = rts.make_statevar("s2", boolsort);
+  PonoOptions parallel;
+  parallel.ic3_propagation_threads_ = 2;
+  // collect the unused labels whenever a new one is created
+  PonoOptions label_gc;
+  label_gc.ic3_label_gc_ = 1;
+  for (const PonoOptions & opts : { PonoOptions(), parallel, label_gc }) {
+    // each run needs its own solver for its labels
+    SmtSolver solver = create_solver(GetParam());
+    Sort bsort = solver->make_sort(BOOL);
+    RelationalTransitionSystem rts(solver);
+    Term s1 = rts.make_statevar("s1", bsort);
+    Term s2 = rts.make_statevar("s2", bsort);
 
-  // INIT !s1 & !s2
-  rts.constrain_init(s->make_term(Not, s1));
-  rts.constrain_init(s->make_term(Not, s2));
+    // INIT !s1 & !s2
+    rts.constrain_init(solver->make_term(Not, s1));
+    rts.constrain_init(solver->make_term(Not, s2));
 
-  // TRANS next(s1) = (s1 | s2)
-  // TRANS next(s2) = s2
-  rts.assign_next(s1, s->make_term(Or, s1, s2));
-  rts.assign_next(s2, s2);
+    // TRANS next(s1) = (s1 | s2)
+    // TRANS next(s2) = s2
+    rts.assign_next(s1, solver->make_term(Or, s1, s2));
+    rts.assign_next(s2, s2);
 
-  Property p(s, s->make_term(Not, s1));
+    Property p(solver, solver->make_term(Not, s1));
+
+    IC3 ic3(p, rts, solver, opts);
+    ProverResult r = ic3.prove();
+    ASSERT_EQ(r, TRUE);
+
+    // get the invariant
+    Term invar = ic3.invar();
+    ASSERT_TRUE(check_invar(rts, p.prop(), invar));
+  }
+}
+
+TEST_P(IC3UnitTests, ParallelPropagation)
+{
+  // the same clauses are pushed with and without worker solvers
+  for (size_t threads : { 1, 3 }) {
+    SmtSolver solver = create_solver(GetParam());
+    Sort bsort = solver->make_sort(BOOL);
+    RelationalTransitionSystem rts(solver);
+    Term s1 = rts.make_statevar("s1", bsort);
+    Term s2 = rts.make_statevar("s2", bsort);
+    Term s3 = rts.make_statevar("s3", bsort);
+    for (const auto & v : { s1, s2, s3 }) {
+      rts.constrain_init(solver->make_term(Not, v));
+    }
+    rts.assign_next(s1, solver->make_term(Or, s1, s2));
+    rts.assign_next(s2, solver->make_term(Or, s2, s3));
+    rts.assign_next(s3, s3);
+
+    Term not_s1 = solver->make_term(Not, s1);
+    Term not_s3 = solver->make_term(Not, s3);
+    Property p(solver, not_s1);
+    PonoOptions opts;
+    opts.ic3_propagation_threads_ = threads;
+    IC3Internals ic3(p, rts, solver, opts);
+    ic3.initialize();
+    ic3.push_frame();
+
+    // !s3 is inductive, !s1 is not without !s2
+    ic3.constrain_frame(1, IC3Formula(not_s1, { not_s1 }, true));
+    ic3.constrain_frame(1, IC3Formula(not_s3, { not_s3 }, true));
+    EXPECT_FALSE(ic3.propagate(1));
+    EXPECT_EQ(ic3.prop_workers_.size(), threads > 1 ? threads : 0);
+
+    const FrameDB & frames = ic3.frames_;
+    ASSERT_EQ(frames.frame(1).size(), 1u);
+    EXPECT_EQ(frames.lemma(frames.frame(1)[0]).term, not_s1);
+    ASSERT_EQ(frames.frame(2).size(), 1u);
+    EXPECT_EQ(frames.lemma(frames.frame(2)[0]).term, not_s3);
+  }
+}
+
+TEST_P(IC3UnitTests, LabelGC)
+{
+  SmtSolver solver = create_solver(GetParam());
+  Sort bsort = solver->make_sort(BOOL);
+  RelationalTransitionSystem rts(solver);
+  Term s1 = rts.make_statevar("s1", bsort);
+  Term s2 = rts.make_statevar("s2", bsort);
+  rts.constrain_init(solver->make_term(Not, s1));
+  rts.assign_next(s1, s2);
+
+  Property p(solver, solver->make_term(Not, s1));
+  IC3Internals ic3(p, rts, solver);
+  ic3.initialize();
+
+  Term l1 = ic3.label(s1);
+  Term l2 = ic3.label(s2);
+  EXPECT_EQ(ic3.label(s1), l1);
+  EXPECT_EQ(ic3.labels_.size(), 2u);
+
+  // s1 is still referenced once
+  ic3.release_labels({ s1, s2 });
+  ic3.collect_labels(true);
+  EXPECT_EQ(ic3.labels_.size(), 1u);
+  EXPECT_EQ(ic3.label(s1), l1);
+
+  // the collected label is disabled, s2 gets a new one
+  Term l2_new = ic3.label(s2);
+  EXPECT_NE(l2_new, l2);
+  EXPECT_TRUE(solver->check_sat_assuming({ l2 }).is_unsat());
+  EXPECT_TRUE(solver->check_sat_assuming({ l2_new }).is_sat());
+
+  ic3.release_labels({ s1, s1, s2 });
+  ic3.collect_labels(true);
+  EXPECT_EQ(ic3.labels_.size(), 0u);
+}
+
+TEST_P(IC3UnitTests, DownAndCTG)
+{
+  for (unsigned int mode : { 1, 2 }) {
+    for (bool safe : { true, false }) {
+      SmtSolver solver = create_solver(GetParam());
+      RelationalTransitionSystem rts(solver);
+      TermVec bits = shift_register(rts, 4, safe);
+
+      Property p(solver, solver->make_term(Not, bits[3]));
+      PonoOptions opts;
+      opts.mbic3_indgen_mode = mode;
+      IC3 ic3(p, rts, solver, opts);
+      ProverResult r = ic3.prove();
+      if (safe) {
+        ASSERT_EQ(r, TRUE);
+        ASSERT_TRUE(check_invar(rts, p.prop(), ic3.invar()));
+      } else {
+        ASSERT_EQ(r, FALSE);
+      }
+    }
+  }
+}
+
+TEST_P(IC3UnitTests, TernarySim)
+{
+  for (bool safe : { true, false }) {
+    SmtSolver solver = create_solver(GetParam());
+    FunctionalTransitionSystem fts(solver);
+    TermVec bits = shift_register(fts, 4, safe);
+
+    Property p(solver, solver->make_term(Not, bits[3]));
+    PonoOptions opts;
+    opts.ic3_ternary_sim_ = true;
+    IC3 ic3(p, fts, solver, opts);
+    ProverResult r = ic3.prove();
+    if (safe) {
+      ASSERT_EQ(r, TRUE);
+      ASSERT_TRUE(check_invar(fts, p.prop(), ic3.invar()));
+    } else {
+      ASSERT_EQ(r, FALSE);
+    }
+  }
+}
+
+TEST_P(IC3UnitTests, TernarySimConstraints)
+{
+  SmtSolver solver = create_solver(GetParam());
+  Sort bsort = solver->make_sort(BOOL);
 
-  IC3 ic3(p, rts, s);
+  // z can only be set with in, which the invariant rules out once w is
+  // set. The predecessor x /\ !w /\ in of z must not be lifted to x
+  FunctionalTransitionSystem fts(solver);
+  Term x = fts.make_statevar("x", bsort);
+  Term y = fts.make_statevar("y", bsort);
+  Term w = fts.make_statevar("w", bsort);
+  Term z = fts.make_statevar("z", bsort);
+  Term in = fts.make_inputvar("in", bsort);
+  Term in2 = fts.make_inputvar("in2", bsort);
+  for (const auto & v : { x, y, w, z }) {
+    fts.constrain_init(solver->make_term(Not, v));
+  }
+  fts.assign_next(x, in2);
+  fts.assign_next(y, solver->make_term(And, w, in));
+  fts.assign_next(w, solver->make_term(true));
+  fts.assign_next(z, solver->make_term(And, x, in));
+  fts.add_invar(solver->make_term(Not, y));
+  ASSERT_TRUE(fts.is_functional());
+  ASSERT_FALSE(fts.is_deterministic());
+
+  Property p(solver, solver->make_term(Not, z));
+  PonoOptions opts;
+  opts.ic3_ternary_sim_ = true;
+  IC3 ic3(p, fts, solver, opts);
   ProverResult r = ic3.prove();
   ASSERT_EQ(r, TRUE);
+  ASSERT_TRUE(check_invar(fts, p.prop(), ic3.invar()));
+}
+
+TEST_P(IC3UnitTests, ResetPolicy)
+{
+  for (bool safe : { true, false }) {
+    SmtSolver solver = create_solver(GetParam());
+    RelationalTransitionSystem rts(solver);
+    TermVec bits = shift_register(rts, 4, safe);
+
+    // the frames are reloaded after every reset
+    Property p(solver, solver->make_term(Not, bits[3]));
+    AlwaysResetIC3 ic3(p, rts, solver);
+    ProverResult r = ic3.prove();
+    EXPECT_GT(ic3.num_resets, 0u);
+    if (safe) {
+      ASSERT_EQ(r, TRUE);
+      ASSERT_TRUE(check_invar(rts, p.prop(), ic3.invar()));
+    } else {
+      ASSERT_EQ(r, FALSE);
+    }
+  }
+}
+
+TEST_P(IC3UnitTests, PredecessorBatching)
+{
+  for (bool safe : { true, false }) {
+    SmtSolver solver = create_solver(GetParam());
+
+    // two shift registers, the second one is always safe
+    RelationalTransitionSystem rts(solver);
+    TermVec a = shift_register(rts, 3, safe, "a");
+    TermVec b = shift_register(rts, 3, true, "b");
+
+    Property p(
+        solver,
+        solver->make_term(Not, solver->make_term(Or, a.back(), b.back())));
+    PonoOptions opts;
+    opts.ic3_num_predecessors_ = 3;
+    opts.ic3_batch_goals_ = 4;
+    IC3 ic3(p, rts, solver, opts);
+    ProverResult r = ic3.prove();
+    if (safe) {
+      ASSERT_EQ(r, TRUE);
+      ASSERT_TRUE(check_invar(rts, p.prop(), ic3.invar()));
+    } else {
+      ASSERT_EQ(r, FALSE);
+    }
+  }
+}
+
+TEST_P(IC3UnitTests, Checkpoint)
+{
+  string filename = ::testing::TempDir() + "pono_ic3_checkpoint_"
+                    + std::to_string(GetParam()) + ".smt2";
+  std::remove(filename.c_str());
 
-  // get the invariant
-  Term invar = ic3.invar();
-  ASSERT_TRUE(check_invar(rts, p.prop(), invar));
+  // each run uses its own solver, like separate processes would
+  // safe: the property holds, otherwise the last bit is reachable
+  auto run = [&](bool safe) {
+    SmtSolver solver = create_solver(GetParam());
+    RelationalTransitionSystem rts(solver);
+    TermVec bits = shift_register(rts, 4, safe);
+
+    Property p(solver, solver->make_term(Not, bits[3]));
+    PonoOptions opts;
+    opts.ic3_checkpoint_ = filename;
+    IC3 ic3(p, rts, solver, opts);
+    ProverResult r = ic3.prove();
+    if (r == TRUE) {
+      EXPECT_TRUE(check_invar(rts, p.prop(), ic3.invar()));
+    }
+    return r;
+  };
+
+  // no checkpoint yet
+  EXPECT_EQ(run(true), TRUE);
+  std::ifstream saved(filename);
+  EXPECT_TRUE(saved.good());
+  saved.close();
+
+  // warm start from the saved lemmas
+  EXPECT_EQ(run(true), TRUE);
+
+  // the lemmas don't hold anymore after the change, they are dropped
+  EXPECT_EQ(run(false), FALSE);
+  std::remove(filename.c_str());
 }
 
 TEST_P(IC3UnitTests, SimpleSystemUnsafe)
@@ -76,6 +374,103 @@ TEST_P(IC3UnitTests, SimpleSystemUnsafe)
   ASSERT_EQ(r, FALSE);
 }
 
+TEST_P(IC3UnitTests, ProofGoalQueue)
+{
+  Term a = s->make_symbol("a", boolsort);
+  Term b = s->make_symbol("b", boolsort);
+  IC3Formula ca(a, { a }, false);
+  IC3Formula cb(b, { b }, false);
+
+  ProofGoalQueue q;
+  ProofGoal * pa = q.make(ca, 3u);
+  q.push(pa);
+  q.push_new(cb, 1, pa);
+  q.push_new(ca, 2, pa);
+  EXPECT_EQ(q.num_created(), 3u);
+  EXPECT_EQ(q.num_resident(), 3u);
+
+  // lowest frame first
+  ProofGoal * top = q.top();
+  EXPECT_EQ(top->idx, 1u);
+  EXPECT_EQ(top->target->term, b);
+  EXPECT_EQ(top->next, pa);
+  q.pop();
+
+  // goals for the same formula share it
+  top = q.top();
+  EXPECT_EQ(top->idx, 2u);
+  EXPECT_EQ(top->target, pa->target);
+  q.pop();
+
+  // rescheduling doesn't create a new goal
+  q.reschedule(top, 4u);
+  EXPECT_EQ(q.num_created(), 3u);
+  EXPECT_EQ(q.num_reused(), 1u);
+  EXPECT_EQ(q.top(), pa);
+  q.pop();
+  EXPECT_EQ(q.top(), top);
+  EXPECT_EQ(top->idx, 4u);
+  q.pop();
+  EXPECT_TRUE(q.empty());
+
+  // memory is recycled after clear
+  q.clear();
+  EXPECT_EQ(q.num_resident(), 0u);
+  EXPECT_EQ(q.make(cb, 0), pa);
+  EXPECT_EQ(q.num_resident(), 1u);
+  EXPECT_EQ(q.num_created(), 4u);
+}
+
+TEST_P(IC3UnitTests, FrameDB)
+{
+  TermVec lits;
+  for (size_t i = 0; i < 4; ++i) {
+    lits.push_back(s->make_symbol("l" + std::to_string(i), boolsort));
+  }
+  auto clause = [this](const TermVec & c) {
+    Term t = c[0];
+    for (size_t i = 1; i < c.size(); ++i) {
+      t = s->make_term(Or, t, c[i]);
+    }
+    return IC3Formula(t, c, true);
+  };
+
+  FrameDB db;
+  for (size_t i = 0; i < 4; ++i) {
+    db.push_frame();
+  }
+  db.add(1, clause({ lits[0], lits[1], lits[2] }));
+  db.add(2, clause({ lits[1], lits[3] }));
+  db.add(3, clause({ lits[2], lits[3] }));
+  EXPECT_EQ(db.num_lemmas(), 3u);
+
+  // syntactic subsumption from a frame up
+  IC3Formula c123 = clause({ lits[1], lits[2], lits[3] });
+  EXPECT_TRUE(db.subsumed(3, c123));
+  EXPECT_TRUE(db.subsumed(2, clause({ lits[1], lits[3] })));
+  EXPECT_FALSE(db.subsumed(3, clause({ lits[1], lits[3] })));
+  EXPECT_FALSE(db.subsumed(1, clause({ lits[0], lits[1] })));
+
+  // only frames 1 to i are checked
+  EXPECT_EQ(db.remove_subsumed(2, clause({ lits[3] })), 1u);
+  EXPECT_EQ(db.num_lemmas(), 2u);
+  EXPECT_EQ(db.frame(2).size(), 0u);
+  EXPECT_EQ(db.frame(3).size(), 1u);
+  EXPECT_EQ(db.remove_subsumed(3, clause({ lits[0], lits[2] })), 1u);
+  EXPECT_EQ(db.frame(1).size(), 0u);
+
+  db.remove(db.frame(3)[0]);
+  EXPECT_EQ(db.num_lemmas(), 0u);
+  EXPECT_FALSE(db.subsumed(0, c123));
+
+  // removed lemmas are dropped when a frame is pushed
+  db.push_frame();
+  EXPECT_EQ(db.size(), 5u);
+  size_t id = db.add(4, clause({ lits[0] }));
+  EXPECT_EQ(id, 0u);
+  EXPECT_TRUE(db.subsumed(4, clause({ lits[0], lits[1] })));
+}
+
 INSTANTIATE_TEST_SUITE_P(ParameterizedSolverIC3UnitTests,
                          IC3UnitTests,
                          testing::ValuesIn(available_solver_enums()));
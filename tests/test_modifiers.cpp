@@ -7,6 +7,8 @@
 #include "modifiers/history_modifier.h"
 #include "modifiers/implicit_predicate_abstractor.h"
 #include "modifiers/prophecy_modifier.h"
+#include "modifiers/state_var_merger.h"
+#include "modifiers/ts_simplifier.h"
 #include "smt-switch/utils.h"
 #include "smt/available_solvers.h"
 #include "tests/common_ts.h"
@@ -135,6 +137,117 @@ TEST_P(ModifierUnitTests, ImplicitPredicateAbstractor)
   EXPECT_TRUE(r.is_unsat());  // expecting it to be inductive now
 }
 
+TEST_P(ModifierUnitTests, TransitionSystemSimplifier)
+{
+  FunctionalTransitionSystem fts(s);
+  Term max_val = fts.make_term(10, bvsort);
+  counter_system(fts, max_val);
+  Term x = fts.named_terms().at("x");
+  Term zero = fts.make_term(0, bvsort);
+  Term one = fts.make_term(1, bvsort);
+
+  // y is an exact copy of the counter x
+  Term y = fts.make_statevar("y", bvsort);
+  fts.constrain_init(fts.make_term(Equal, y, zero));
+  fts.assign_next(
+      y,
+      fts.make_term(Ite,
+                    fts.make_term(BVUlt, y, max_val),
+                    fts.make_term(BVAdd, y, one),
+                    zero));
+
+  // z is always zero
+  Term z = fts.make_statevar("z", bvsort);
+  fts.constrain_init(fts.make_term(Equal, z, zero));
+  fts.assign_next(z, fts.make_term(BVAnd, z, x));
+
+  // w depends on an input
+  Term in = fts.make_inputvar("in", bvsort);
+  Term w = fts.make_statevar("w", bvsort);
+  fts.constrain_init(fts.make_term(Equal, w, zero));
+  Term c = fts.make_term(BVUlt, in, x);
+  fts.assign_next(w, fts.make_term(Ite, c, in, in));
+
+  TransitionSystemSimplifier simplifier(fts);
+
+  // slice/concat normalization and constant folding
+  Term xw = fts.make_term(Concat, x, w);
+  EXPECT_EQ(w, simplifier.simplify_term(fts.make_term(Op(Extract, 7, 0), xw)));
+  EXPECT_EQ(zero, simplifier.simplify_term(fts.make_term(BVAnd, w, zero)));
+  EXPECT_EQ(fts.make_term(3, bvsort),
+            simplifier.simplify_term(fts.make_term(
+                BVAdd, one, fts.make_term(2, bvsort))));
+
+  Term y_next = fts.next(y);
+  TermVec props({ fts.make_term(BVUle, fts.make_term(BVAdd, y, z), max_val) });
+  simplifier.simplify(props);
+
+  EXPECT_EQ(2u, simplifier.num_merged_statevars());
+  EXPECT_EQ(2u, fts.statevars().size());
+  EXPECT_TRUE(fts.statevars().find(x) != fts.statevars().end());
+  EXPECT_TRUE(fts.statevars().find(w) != fts.statevars().end());
+  // merged variables are gone from the current/next maps as well
+  EXPECT_FALSE(fts.is_next_var(y_next));
+  EXPECT_EQ(y, fts.next(y));
+  EXPECT_EQ(y_next, fts.curr(y_next));
+  // the names of merged variables refer to their representatives
+  EXPECT_EQ(x, fts.named_terms().at("y"));
+  EXPECT_EQ(fts.next(x), fts.named_terms().at("y.next"));
+  EXPECT_EQ("x", fts.get_name(x));
+  EXPECT_EQ("x.next", fts.get_name(fts.next(x)));
+  // ite(c, in, in) -> in
+  EXPECT_EQ(in, fts.state_updates().at(w));
+
+  // the property is rewritten in terms of the remaining variables
+  UnorderedTermSet free_vars;
+  get_free_symbolic_consts(props[0], free_vars);
+  EXPECT_EQ(1u, free_vars.size());
+  EXPECT_TRUE(free_vars.find(x) != free_vars.end());
+}
+
+TEST_P(ModifierUnitTests, StateVarMerger)
+{
+  FunctionalTransitionSystem fts(s);
+  Term max_val = fts.make_term(10, bvsort);
+  counter_system(fts, max_val);
+  Term x = fts.named_terms().at("x");
+  Term zero = fts.make_term(0, bvsort);
+  Term one = fts.make_term(1, bvsort);
+
+  // y counts like x, with a different (but equivalent) update
+  Term y = fts.make_statevar("y", bvsort);
+  fts.constrain_init(fts.make_term(Equal, y, zero));
+  fts.assign_next(y,
+                  fts.make_term(Ite,
+                                fts.make_term(BVUge, y, max_val),
+                                zero,
+                                fts.make_term(BVAdd, y, one)));
+
+  // z stays at reset forever
+  Term z = fts.make_statevar("z", bvsort);
+  fts.constrain_init(fts.make_term(Equal, z, zero));
+  fts.assign_next(z, fts.make_term(BVMul, z, x));
+
+  // w follows an input and is not equivalent to anything
+  Term in = fts.make_inputvar("in", bvsort);
+  Term w = fts.make_statevar("w", bvsort);
+  fts.constrain_init(fts.make_term(Equal, w, zero));
+  fts.assign_next(w, in);
+
+  TermVec props({ fts.make_term(BVUle, fts.make_term(BVAdd, y, z), max_val) });
+  StateVarMerger merger(fts);
+  EXPECT_EQ(2u, merger.merge(props));
+
+  EXPECT_EQ(2u, fts.statevars().size());
+  EXPECT_TRUE(fts.statevars().find(x) != fts.statevars().end());
+  EXPECT_TRUE(fts.statevars().find(w) != fts.statevars().end());
+
+  UnorderedTermSet free_vars;
+  get_free_symbolic_consts(props[0], free_vars);
+  EXPECT_EQ(1u, free_vars.size());
+  EXPECT_TRUE(free_vars.find(x) != free_vars.end());
+}
+
 INSTANTIATE_TEST_SUITE_P(ParameterizedModifierUnitTests,
                          ModifierUnitTests,
                          testing::ValuesIn(available_solver_enums()));
@@ -0,0 +1,213 @@
+#include <utility>
+#include <vector>
+
+#include "core/fts.h"
+#include "core/simulator.h"
+#include "core/ternary_sim.h"
+#include "gtest/gtest.h"
+#include "smt/available_solvers.h"
+#include "tests/common_ts.h"
+#include "utils/exceptions.h"
+
+using namespace pono;
+using namespace smt;
+using namespace std;
+
+namespace pono_tests {
+
+class SimulatorUnitTests : public ::testing::Test,
+                           public ::testing::WithParamInterface<SolverEnum>
+{
+ protected:
+  void SetUp() override
+  {
+    s = create_solver(GetParam());
+    bvsort = s->make_sort(BV, 8);
+  }
+  SmtSolver s;
+  Sort bvsort;
+};
+
+/** Value of a compiled term in one lane (for widths up to 64) */
+static uint64_t lane_value(const Simulator & sim, const Term & t, size_t lane)
+{
+  const uint64_t * b = sim.bits(t);
+  uint64_t res = 0;
+  for (size_t j = 0; j < sim.width(t); ++j) {
+    res |= ((b[j] >> lane) & 1ull) << j;
+  }
+  return res;
+}
+
+TEST_P(SimulatorUnitTests, Counter)
+{
+  FunctionalTransitionSystem fts(s);
+  Term max_val = fts.make_term(10, bvsort);
+  counter_system(fts, max_val);
+  Term x = fts.named_terms().at("x");
+
+  Simulator sim(fts);
+  sim.reset();
+  for (size_t i = 0; i < 25; ++i) {
+    EXPECT_EQ(i % 11, lane_value(sim, x, 0));
+    EXPECT_EQ(i % 11, lane_value(sim, x, Simulator::num_lanes - 1));
+    sim.step();
+  }
+  EXPECT_EQ(~0ull, sim.valid_lanes());
+}
+
+TEST_P(SimulatorUnitTests, Operators)
+{
+  FunctionalTransitionSystem fts(s);
+  Term a = fts.make_inputvar("a", bvsort);
+  Term b = fts.make_inputvar("b", bvsort);
+  Term amt = fts.make_term(BVAnd, b, fts.make_term(15, bvsort));
+
+  TermVec terms({ fts.make_term(BVAdd, a, b),
+                  fts.make_term(BVSub, a, b),
+                  fts.make_term(BVMul, a, b),
+                  fts.make_term(BVUdiv, a, b),
+                  fts.make_term(BVUrem, a, b),
+                  fts.make_term(BVSdiv, a, b),
+                  fts.make_term(BVSrem, a, b),
+                  fts.make_term(BVSmod, a, b),
+                  fts.make_term(BVShl, a, amt),
+                  fts.make_term(BVLshr, a, amt),
+                  fts.make_term(BVAshr, a, amt),
+                  fts.make_term(BVNeg, a),
+                  fts.make_term(Op(Extract, 6, 2), a),
+                  fts.make_term(Concat, a, b),
+                  fts.make_term(Op(Sign_Extend, 4), a),
+                  fts.make_term(Op(Rotate_Left, 3), a),
+                  fts.make_term(Ite, fts.make_term(BVSlt, a, b), a, b),
+                  fts.make_term(Ite, fts.make_term(BVUge, a, b), a, b) });
+
+  Simulator sim(fts, 1);
+  for (const auto & t : terms) {
+    sim.add_term(t);
+  }
+  sim.reset();
+
+  // compare a few lanes against the solver
+  for (size_t lane = 0; lane < 8; ++lane) {
+    Term va = fts.make_term((int64_t)lane_value(sim, a, lane), bvsort);
+    Term vb = fts.make_term((int64_t)lane_value(sim, b, lane), bvsort);
+    s->push();
+    s->assert_formula(s->make_term(Equal, a, va));
+    s->assert_formula(s->make_term(Equal, b, vb));
+    ASSERT_TRUE(s->check_sat().is_sat());
+    for (const auto & t : terms) {
+      Term expected = s->get_value(t);
+      Sort sort = t->get_sort();
+      Term got = fts.make_term((int64_t)lane_value(sim, t, lane), sort);
+      EXPECT_EQ(expected, got) << t;
+    }
+    s->pop();
+  }
+}
+
+TEST_P(SimulatorUnitTests, Arrays)
+{
+  FunctionalTransitionSystem fts(s);
+  Sort addrsort = s->make_sort(BV, 4);
+  Sort memsort = s->make_sort(ARRAY, addrsort, bvsort);
+  Term addr = fts.make_inputvar("addr", addrsort);
+  Term data = fts.make_inputvar("data", bvsort);
+  Term mem = fts.make_statevar("mem", memsort);
+  fts.constrain_init(
+      fts.make_term(Equal, mem, fts.make_term(fts.make_term(0, bvsort), memsort)));
+  fts.assign_next(mem, fts.make_term(Store, mem, addr, data));
+  Term rd = fts.make_term(Select, mem, addr);
+
+  Simulator sim(fts, 2);
+  EXPECT_TRUE(sim.exact());
+  sim.add_term(rd);
+  sim.reset();
+
+  // reference memories for a few lanes
+  vector<vector<uint64_t>> model(4, vector<uint64_t>(16, 0));
+  for (size_t i = 0; i < 20; ++i) {
+    for (size_t lane = 0; lane < model.size(); ++lane) {
+      uint64_t a = lane_value(sim, addr, lane);
+      EXPECT_EQ(model[lane][a], lane_value(sim, rd, lane));
+    }
+    for (size_t lane = 0; lane < model.size(); ++lane) {
+      model[lane][lane_value(sim, addr, lane)] = lane_value(sim, data, lane);
+    }
+    sim.step();
+  }
+
+  // the value of the array in a lane agrees with the model
+  Term memval = sim.value(mem, 0);
+  for (uint64_t a = 0; a < 16; ++a) {
+    Term idx = fts.make_term((int64_t)a, addrsort);
+    s->push();
+    s->assert_formula(s->make_term(
+        Distinct,
+        s->make_term(Select, memval, idx),
+        fts.make_term((int64_t)model[0][a], bvsort)));
+    EXPECT_TRUE(s->check_sat().is_unsat());
+    s->pop();
+  }
+}
+
+TEST_P(SimulatorUnitTests, TernaryLifting)
+{
+  FunctionalTransitionSystem fts(s);
+  Term a = fts.make_statevar("a", bvsort);
+  Term b = fts.make_statevar("b", bvsort);
+  Term in = fts.make_inputvar("in", bvsort);
+  fts.assign_next(a, fts.make_term(BVAnd, a, b));
+  fts.assign_next(b, fts.make_term(BVAdd, b, in));
+
+  TernarySimulator tsim(fts);
+  EXPECT_EQ(TernarySimulator::X,
+            tsim.eval(fts.make_term(Equal, a, fts.make_term(0, bvsort))));
+
+  tsim.assign(a, fts.make_term(0x0F, bvsort));
+  tsim.assign(b, fts.make_term(0xF0, bvsort));
+  tsim.assign(in, fts.make_term(1, bvsort));
+
+  // n-ary distinct compares every pair, a equals the last argument
+  Term dist_last =
+      fts.make_term(Distinct, TermVec{ a, b, fts.make_term(0x0F, bvsort) });
+  EXPECT_EQ(TernarySimulator::ZERO, tsim.eval(dist_last));
+  Term dist =
+      fts.make_term(Distinct, TermVec{ a, b, fts.make_term(0x01, bvsort) });
+  EXPECT_EQ(TernarySimulator::ONE, tsim.eval(dist));
+
+  // in the next state, the low nibble of a is 0 whatever a is
+  Term low = fts.make_term(Op(Extract, 3, 0), a);
+  Term target =
+      fts.make_term(Equal, low, fts.make_term(0, s->make_sort(BV, 4)));
+  EXPECT_EQ(TernarySimulator::ONE, tsim.eval(target, true));
+
+  TermVec needed;
+  ASSERT_TRUE(tsim.lift({ a, b }, target, true, needed));
+  ASSERT_EQ(1u, needed.size());
+  EXPECT_EQ(b, needed[0]);
+
+  // a was dropped, only the low nibble of the next a is known
+  vector<TernarySimulator::Trit> bits = tsim.eval_bits(a, true);
+  ASSERT_EQ(8u, bits.size());
+  for (size_t j = 0; j < 8; ++j) {
+    EXPECT_EQ(j < 4 ? TernarySimulator::ZERO : TernarySimulator::X, bits[j]);
+  }
+
+  // next(b) = 0xF1, the carry is known
+  Term bnext_gt = fts.make_term(BVUgt, b, fts.make_term(0xF0, bvsort));
+  EXPECT_EQ(TernarySimulator::ONE, tsim.eval(bnext_gt, true));
+  tsim.unassign(in);
+  EXPECT_EQ(TernarySimulator::X, tsim.eval(bnext_gt, true));
+
+  // the target doesn't hold: nothing is lifted
+  tsim.assign(a, fts.make_term(0x0F, bvsort));
+  tsim.assign(b, fts.make_term(0x0F, bvsort));
+  EXPECT_FALSE(tsim.lift({ a, b }, target, true, needed));
+}
+
+INSTANTIATE_TEST_SUITE_P(ParameterizedSimulatorUnitTests,
+                         SimulatorUnitTests,
+                         testing::ValuesIn(available_solver_enums()));
+
+}  // namespace pono_tests
@@ -5,6 +5,7 @@
 #include "core/fts.h"
 #include "core/functional_unroller.h"
 #include "core/rts.h"
+#include "core/simple_path.h"
 #include "core/unroller.h"
 #include "gtest/gtest.h"
 #include "smt-switch/utils.h"
@@ -125,6 +126,51 @@ TEST_P(UnrollerUnitTests, StagedUnrolling)
   EXPECT_EQ(x4py4_2, x4py4);
 }
 
+TEST_P(UnrollerUnitTests, SubtermCache)
+{
+  RelationalTransitionSystem rts(s);
+  counter_system(rts, rts.make_term(10, bvsort));
+  Term x = rts.named_terms().at("x");
+
+  Unroller u(rts, s);
+  Term trans2 = u.at_time(rts.trans(), 2);
+  size_t misses = u.num_cache_misses();
+  EXPECT_GT(misses, 0u);
+
+  // unrolling the same term again is a single lookup
+  EXPECT_EQ(trans2, u.at_time(rts.trans(), 2));
+  EXPECT_EQ(misses, u.num_cache_misses());
+  EXPECT_EQ(1u, u.num_cache_hits());
+
+  // a term sharing subterms with trans only rebuilds the new part
+  Term x_inc = rts.make_term(BVAdd, x, rts.make_term(1, bvsort));
+  Term conj = rts.make_term(And, rts.trans(), rts.make_term(BVUlt, x_inc, x));
+  Term conj2 = u.at_time(conj, 2);
+  EXPECT_GT(u.num_cache_hits(), 1u);
+
+  UnorderedTermSet free_vars;
+  get_free_symbolic_consts(conj2, free_vars);
+  EXPECT_TRUE(free_vars.find(u.at_time(x, 2)) != free_vars.end());
+  EXPECT_TRUE(free_vars.find(x) == free_vars.end());
+
+  // unrolling at another time doesn't reuse subterms of time 2
+  Term trans3 = u.at_time(rts.trans(), 3);
+  EXPECT_NE(trans2, trans3);
+
+  // equivalent to a substitution of the whole term
+  UnorderedTermMap subst;
+  for (const auto & v : rts.statevars()) {
+    subst[v] = u.at_time(v, 3);
+    subst[rts.next(v)] = u.at_time(rts.next(v), 3);
+  }
+  for (const auto & v : rts.inputvars()) {
+    subst[v] = u.at_time(v, 3);
+  }
+  s->assert_formula(
+      s->make_term(Distinct, trans3, s->substitute(rts.trans(), subst)));
+  EXPECT_TRUE(s->check_sat().is_unsat());
+}
+
 TEST_P(UnrollerUnitTests, AdaptiveUnroller)
 {
   RelationalTransitionSystem rts(s);
@@ -249,6 +295,74 @@ TEST_P(UnrollerUnitTests, IntermittentFunctionalUnrolling)
   EXPECT_TRUE(r.is_unsat());
 }
 
+TEST_P(UnrollerUnitTests, SimplePath)
+{
+  s->set_opt("produce-models", "true");
+  s->set_opt("incremental", "true");
+  RelationalTransitionSystem rts(s);
+  Term x = rts.make_statevar("x", bvsort);
+  Term y = rts.make_statevar("y", bvsort);
+
+  Unroller u(rts, s);
+  SimplePathEncoder sp(rts, u, s);
+  // constraints are cached and symmetric
+  Term c02 = sp.constraint(0, 2);
+  EXPECT_EQ(c02, sp.constraint(2, 0));
+  EXPECT_NE(c02, sp.constraint(0, 1));
+
+  // states 0, 2 and 3 are equal
+  Term three = s->make_term(3, bvsort);
+  for (int t = 0; t < 4; ++t) {
+    Term xt = (t == 1) ? s->make_term(4, bvsort) : three;
+    s->assert_formula(s->make_term(Equal, u.at_time(x, t), xt));
+    s->assert_formula(s->make_term(Equal, u.at_time(y, t), three));
+  }
+  ASSERT_TRUE(s->check_sat().is_sat());
+
+  TermVec violated = sp.violated(3);
+  ASSERT_EQ(violated.size(), 2u);
+  UnorderedTermSet expected({ c02, sp.constraint(2, 3) });
+  EXPECT_EQ(UnorderedTermSet(violated.begin(), violated.end()), expected);
+
+  EXPECT_EQ(sp.violated(1).size(), 0u);
+  for (const auto & c : violated) {
+    s->assert_formula(c);
+  }
+  EXPECT_TRUE(s->check_sat().is_unsat());
+}
+
+TEST_P(UnrollerUnitTests, SimplePathArrays)
+{
+  s->set_opt("produce-models", "true");
+  s->set_opt("incremental", "true");
+  RelationalTransitionSystem rts(s);
+  Sort arrsort = s->make_sort(ARRAY, bvsort, bvsort);
+  Term x = rts.make_statevar("x", bvsort);
+  Term a = rts.make_statevar("a", arrsort);
+
+  Unroller u(rts, s);
+  SimplePathEncoder sp(rts, u, s);
+
+  // a@0 = store(a@1, 0, 3) with a@1[0] = 3, so the arrays are equal
+  // even if their values in the model are built differently
+  Term zero = s->make_term(0, bvsort);
+  Term three = s->make_term(3, bvsort);
+  Term a0 = u.at_time(a, 0);
+  Term a1 = u.at_time(a, 1);
+  s->assert_formula(
+      s->make_term(Equal, a0, s->make_term(Store, a1, zero, three)));
+  s->assert_formula(
+      s->make_term(Equal, s->make_term(Select, a1, zero), three));
+  for (int t = 0; t < 2; ++t) {
+    s->assert_formula(s->make_term(Equal, u.at_time(x, t), three));
+  }
+  ASSERT_TRUE(s->check_sat().is_sat());
+
+  TermVec violated = sp.violated(1);
+  ASSERT_EQ(violated.size(), 1u);
+  EXPECT_EQ(violated[0], sp.constraint(0, 1));
+}
+
 INSTANTIATE_TEST_SUITE_P(ParameterizedUnrollerUnitTests,
                          UnrollerUnitTests,
                          testing::ValuesIn(available_solver_enums()));
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cstdio>
 #include <utility>
 #include <vector>
 
@@ -6,10 +8,15 @@
 #include "core/unroller.h"
 #include "engines/kinduction.h"
 #include "gtest/gtest.h"
+#include "smt-switch/term_translator.h"
 #include "smt/available_solvers.h"
 #include "tests/common_ts.h"
 #include "utils/exceptions.h"
+#include "utils/invariant_cache.h"
+#include "utils/invariant_miner.h"
+#include "utils/lemma_bus.h"
 #include "utils/make_provers.h"
+#include "utils/term_io.h"
 #include "utils/term_walkers.h"
 #include "utils/ts_analysis.h"
 
@@ -114,6 +121,165 @@ TEST_P(UtilsUnitTests, CheckInvarFalseNonState)
   EXPECT_FALSE(check_invar(rts, prop, invar));
 }
 
+TEST_P(UtilsUnitTests, InductiveSubset)
+{
+  RelationalTransitionSystem rts(s);
+  Term x = rts.make_statevar("x", bvsort);
+  Term y = rts.make_statevar("y", bvsort);
+  Term zero = rts.make_term(0, bvsort);
+  rts.constrain_init(rts.make_term(Equal, x, zero));
+  rts.constrain_init(rts.make_term(Equal, y, zero));
+  // x' = x < 10 ? x + 1 : 0
+  rts.assign_next(
+      x,
+      rts.make_term(Ite,
+                    rts.make_term(BVUlt, x, rts.make_term(10, bvsort)),
+                    rts.make_term(BVAdd, x, rts.make_term(1, bvsort)),
+                    zero));
+  rts.assign_next(y, y);
+
+  Term x_le_10 = rts.make_term(BVUle, x, rts.make_term(10, bvsort));
+  Term x_le_5 = rts.make_term(BVUle, x, rts.make_term(5, bvsort));
+  Term y_eq_0 = rts.make_term(Equal, y, zero);
+  Term y_eq_1 = rts.make_term(Equal, y, rts.make_term(1, bvsort));
+
+  TermVec kept = inductive_subset(rts, { x_le_5, x_le_10, y_eq_1, y_eq_0 });
+  EXPECT_EQ(kept, TermVec({ x_le_10, y_eq_0 }));
+
+  // cached invariants are reused for any property they prove
+  string dir = ::testing::TempDir() + "pono_invar_cache";
+  InvariantCache cache(dir, "designs/counter.btor2", "p0");
+  std::remove(cache.filename().c_str());
+  EXPECT_EQ(cache.prove(rts, x_le_10), nullptr);
+
+  cache.store(rts.make_term(And, x_le_5, rts.make_term(And, x_le_10, y_eq_0)));
+  Term prop = rts.make_term(Not, rts.make_term(And, y_eq_1, x_le_10));
+  Term invar = cache.prove(rts, prop);
+  ASSERT_NE(invar, nullptr);
+  EXPECT_TRUE(check_invar(rts, prop, invar));
+  EXPECT_EQ(cache.prove(rts, x_le_5), nullptr);
+  std::remove(cache.filename().c_str());
+}
+
+TEST_P(UtilsUnitTests, InvariantMiner)
+{
+  FunctionalTransitionSystem fts(s);
+  Term x = fts.make_statevar("x", bvsort);
+  Term y = fts.make_statevar("y", bvsort);
+  Term z = fts.make_statevar("z", bvsort);
+  Term zero = fts.make_term(0, bvsort);
+  Term one = fts.make_term(1, bvsort);
+  fts.constrain_init(fts.make_term(Equal, x, zero));
+  fts.constrain_init(fts.make_term(Equal, y, zero));
+  fts.constrain_init(fts.make_term(Equal, z, zero));
+  fts.assign_next(x, fts.make_term(BVAdd, x, one));
+  fts.assign_next(y, fts.make_term(BVAdd, y, one));
+  fts.assign_next(z, z);
+
+  InvariantMiner miner(fts);
+  TermVec invars = miner.mine();
+  Term conj = fts.make_term(true);
+  for (const auto & inv : invars) {
+    conj = fts.make_term(And, conj, inv);
+  }
+  EXPECT_TRUE(check_invar(fts, conj, conj));
+  Term x_eq_y = fts.make_term(Equal, x, y);
+  Term z_eq_0 = fts.make_term(Equal, z, zero);
+  EXPECT_NE(std::find(invars.begin(), invars.end(), x_eq_y), invars.end());
+  EXPECT_NE(std::find(invars.begin(), invars.end(), z_eq_0), invars.end());
+
+  // x = 5 -> y = 5 needs x = y to be k-inductive for small k
+  Term prop = fts.make_term(
+      Implies,
+      fts.make_term(Equal, x, fts.make_term(5, bvsort)),
+      fts.make_term(Equal, y, fts.make_term(5, bvsort)));
+  Property p(s, prop);
+  PonoOptions opts;
+  KInduction kind(p, fts, create_solver(GetParam()), opts);
+  EXPECT_EQ(kind.check_until(2), ProverResult::UNKNOWN);
+
+  opts.kind_mine_invariants_ = true;
+  KInduction kind_mined(p, fts, create_solver(GetParam()), opts);
+  EXPECT_EQ(kind_mined.check_until(2), ProverResult::TRUE);
+}
+
+TEST_P(UtilsUnitTests, LemmaBus)
+{
+  FunctionalTransitionSystem fts(s);
+  counter_system(fts, fts.make_term(10, bvsort));
+  Term x = fts.named_terms().at("x");
+  Term inp = fts.make_inputvar("inp", bvsort);
+
+  // consumer has its own solver and copy of the system
+  SmtSolver s2 = create_solver(GetParam());
+  TermTranslator tt(s2);
+  TransitionSystem fts2(fts, tt);
+
+  LemmaBus bus;
+  LemmaBus::Cursor cursor0 = nullptr;
+  LemmaBus::Cursor cursor1 = nullptr;
+  Term lemma = fts.make_term(BVUle, x, fts.make_term(10, bvsort));
+  EXPECT_TRUE(bus.publish(0, lemma));
+  EXPECT_EQ(bus.size(), 1u);
+
+  // producers don't receive their own lemmas
+  EXPECT_EQ(bus.fetch(0, cursor0, fts).size(), 0u);
+
+  TermVec lemmas = bus.fetch(1, cursor1, fts2);
+  ASSERT_EQ(lemmas.size(), 1u);
+  EXPECT_EQ(lemmas[0], tt.transfer_term(lemma, BOOL));
+
+  // already seen
+  EXPECT_EQ(bus.fetch(1, cursor1, fts2).size(), 0u);
+
+  // inputs are not state variables, so this can't be rebuilt
+  EXPECT_TRUE(bus.publish(0, fts.make_term(BVUle, x, inp)));
+  EXPECT_EQ(bus.fetch(1, cursor1, fts2).size(), 0u);
+
+  // names that need quoting in SMT-LIB
+  Term y = fts.make_statevar("y y", bvsort);
+  fts.assign_next(y, y);
+  TransitionSystem fts3(fts, tt);
+  LemmaBus::Cursor cursor2 = nullptr;
+  lemma = fts.make_term(BVUle, y, x);
+  EXPECT_TRUE(bus.publish(0, lemma));
+  lemmas = bus.fetch(1, cursor2, fts3);
+  // the lemma over the input is still dropped
+  ASSERT_EQ(lemmas.size(), 2u);
+  EXPECT_EQ(lemmas[1], tt.transfer_term(lemma, BOOL));
+}
+
+TEST_P(UtilsUnitTests, TermIO)
+{
+  FunctionalTransitionSystem fts(s);
+  counter_system(fts, fts.make_term(10, bvsort));
+  Term x = fts.named_terms().at("x");
+  Term y = fts.make_statevar("y y", bvsort);
+  Term inp = fts.make_inputvar("inp", bvsort);
+
+  Term hi = fts.make_term(Op(Extract, 7, 4), x);
+  Term lo = fts.make_term(Op(Extract, 3, 0), y);
+  Term ule = fts.make_term(
+      BVUle, fts.make_term(Concat, hi, lo), fts.make_term(10, bvsort));
+  Term neq =
+      fts.make_term(Not, fts.make_term(Equal, x, fts.make_term(200, bvsort)));
+  Term lemma = fts.make_term(Or, ule, neq);
+
+  // symbols with spaces are quoted
+  Term parsed = smtlib_to_term(term_to_smtlib(lemma), fts);
+
+  // the parsed term is equivalent
+  s->push();
+  s->assert_formula(s->make_term(Not, s->make_term(Equal, lemma, parsed)));
+  EXPECT_TRUE(s->check_sat().is_unsat());
+  s->pop();
+
+  // only current state variables can be parsed
+  EXPECT_THROW(smtlib_to_term(term_to_smtlib(inp), fts), PonoException);
+  EXPECT_THROW(smtlib_to_term("(bvadd x z)", fts), PonoException);
+  EXPECT_THROW(smtlib_to_term("(bvadd x", fts), PonoException);
+}
+
 TEST_P(UtilsEngineUnitTests, MakeProver)
 {
   // use default solver
@@ -0,0 +1,158 @@
+/*********************                                                        */
+/*! \file invariant_cache.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief On-disk cache of proven invariants keyed by design and property
+**        name, to re-verify a slightly changed design without running
+**        an engine.
+**
+**
+**/
+
+#include "utils/invariant_cache.h"
+
+#include <sys/stat.h>
+
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+
+#include "utils/exceptions.h"
+#include "utils/logger.h"
+#include "utils/term_io.h"
+#include "utils/ts_analysis.h"
+
+using namespace smt;
+using namespace std;
+
+namespace pono {
+
+/** @return name with every character that is not safe in a file name
+ *          replaced by _
+ */
+static string sanitize(const string & name)
+{
+  string res = name;
+  for (auto & ch : res) {
+    if (!isalnum(ch) && ch != '.' && ch != '-' && ch != '_') {
+      ch = '_';
+    }
+  }
+  return res;
+}
+
+InvariantCache::InvariantCache(const string & dir,
+                               const string & design,
+                               const string & prop_name)
+{
+  // ignore errors, e.g. if it exists already
+  mkdir(dir.c_str(), 0755);
+  string base = design.substr(design.find_last_of('/') + 1);
+  filename_ = dir + "/" + sanitize(base) + "." + sanitize(prop_name) + ".inv";
+}
+
+Term InvariantCache::prove(const TransitionSystem & ts, const Term & prop) const
+{
+  std::ifstream in(filename_);
+  if (!in) {
+    logger.log(1, "No cached invariant in {}", filename_);
+    return nullptr;
+  }
+
+  TermVec candidates;
+  UnorderedTermSet seen({ prop });
+  size_t num_dropped = 0;
+  string line;
+  while (getline(in, line)) {
+    if (line.empty() || line[0] == ';') {
+      continue;
+    }
+    try {
+      Term c = smtlib_to_term(line, ts);
+      if (c->get_sort()->get_sort_kind() != BOOL) {
+        num_dropped++;
+      } else if (seen.insert(c).second) {
+        candidates.push_back(c);
+      }
+    }
+    catch (std::exception & e) {
+      // e.g. a variable was removed or changed its sort
+      logger.log(3, "Dropping cached conjunct {}", e.what());
+      num_dropped++;
+    }
+  }
+  logger.log(1,
+             "Loaded {} conjuncts from {}, dropped {}",
+             candidates.size(),
+             filename_,
+             num_dropped);
+  if (!ts.only_curr(prop)) {
+    return nullptr;
+  }
+  candidates.push_back(prop);
+
+  TermVec invar = inductive_subset(ts, candidates);
+  if (invar.empty() || invar.back() != prop) {
+    logger.log(1, "Cached invariant does not prove the property anymore");
+    return nullptr;
+  }
+
+  Term res = invar[0];
+  for (size_t i = 1; i < invar.size(); ++i) {
+    res = ts.make_term(And, res, invar[i]);
+  }
+  return res;
+}
+
+void InvariantCache::store(const Term & invar) const
+{
+  // flatten the conjunction
+  TermVec conjuncts;
+  TermVec to_visit({ invar });
+  while (to_visit.size()) {
+    Term t = to_visit.back();
+    to_visit.pop_back();
+    if (t->get_op() == And) {
+      to_visit.insert(to_visit.end(), t->begin(), t->end());
+    } else {
+      conjuncts.push_back(t);
+    }
+  }
+
+  // replace the previous invariant atomically
+  string tmp_filename = filename_ + ".tmp";
+  size_t num_stored = 0;
+  {
+    std::ofstream out(tmp_filename);
+    out << "; pono invariant cache, one conjunct per line" << std::endl;
+    for (auto it = conjuncts.rbegin(); it != conjuncts.rend(); ++it) {
+      try {
+        out << term_to_smtlib(*it) << "\n";
+        num_stored++;
+      }
+      catch (PonoException & e) {
+        logger.log(3, "Not caching conjunct {}", e.what());
+      }
+    }
+    if (!out) {
+      logger.log(1, "Failed to write invariant cache {}", tmp_filename);
+      return;
+    }
+  }
+
+  if (std::rename(tmp_filename.c_str(), filename_.c_str())) {
+    logger.log(1, "Failed to replace invariant cache {}", filename_);
+    return;
+  }
+  logger.log(
+      1, "Cached {} conjuncts of the invariant in {}", num_stored, filename_);
+}
+
+}  // namespace pono
@@ -0,0 +1,69 @@
+/*********************                                                        */
+/*! \file invariant_cache.h
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief On-disk cache of proven invariants keyed by design and property
+**        name, to re-verify a slightly changed design without running
+**        an engine.
+**
+**        The conjuncts of an invariant are stored as SMT-LIB terms (see
+**        term_io). When the design changed, the largest subset of the
+**        cached conjuncts that is still inductive is used.
+**
+**/
+
+#pragma once
+
+#include <string>
+
+#include "core/ts.h"
+
+namespace pono {
+
+class InvariantCache
+{
+ public:
+  /** @param dir the directory of the cache files (created if needed)
+   *  @param design the design, e.g. its file name (only the base name
+   *         is used, so the cache survives moving the checkout)
+   *  @param prop_name the name of the property
+   */
+  InvariantCache(const std::string & dir,
+                 const std::string & design,
+                 const std::string & prop_name);
+
+  /** Tries to prove prop with the cached invariant
+   *  The cached conjuncts that can't be parsed in ts are dropped and
+   *  prop is added to the candidates, then the largest inductive subset
+   *  is computed (see inductive_subset).
+   *  @param ts the transition system
+   *  @param prop the property
+   *  @return an inductive invariant that implies prop,
+   *          or nullptr if there is no cached invariant or it doesn't
+   *          prove prop anymore
+   */
+  smt::Term prove(const TransitionSystem & ts, const smt::Term & prop) const;
+
+  /** Stores the top-level conjuncts of a proven invariant, replacing the
+   *  previous invariant of the design and property
+   *  Conjuncts that can't be printed (e.g. with uninterpreted functions)
+   *  are left out.
+   *  @param invar the invariant, over current state variables
+   */
+  void store(const smt::Term & invar) const;
+
+  /** @return the file the invariant is stored in */
+  const std::string & filename() const { return filename_; }
+
+ protected:
+  std::string filename_;
+};
+
+}  // namespace pono
@@ -0,0 +1,207 @@
+/*********************                                                        */
+/*! \file invariant_miner.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Cheap invariant mining for strengthening k-induction.
+**
+**
+**/
+
+#include "utils/invariant_miner.h"
+
+#include <algorithm>
+#include <map>
+
+#include "core/simulator.h"
+#include "utils/logger.h"
+#include "utils/ts_analysis.h"
+
+using namespace smt;
+using namespace std;
+
+namespace pono {
+
+InvariantMiner::InvariantMiner(const TransitionSystem & ts,
+                               unsigned int sim_runs,
+                               unsigned int sim_cycles,
+                               unsigned int seed)
+    : ts_(ts), sim_runs_(sim_runs), sim_cycles_(sim_cycles), seed_(seed)
+{
+}
+
+TermVec InvariantMiner::candidates() const
+{
+  /** What was observed about a variable in all valid lanes and cycles */
+  struct Stats
+  {
+    uint64_t sig = 0;         ///< hash of all values
+    vector<bool> ever_one;    ///< per bit
+    vector<bool> ever_zero;   ///< per bit
+    bool multi_hot = false;   ///< more than one bit was set at once
+    uint64_t max = 0;         ///< largest value (if width <= 64)
+  };
+
+  if (!ts_.is_functional()) {
+    // the simulator needs a functional system
+    logger.log(1, "Invariant mining: skipped, not a functional system");
+    return {};
+  }
+
+  Simulator sim(ts_, seed_);
+  TermVec vars;
+  unordered_map<Term, Stats> stats;
+  for (const auto & v : ts_.statevars()) {
+    // arrays are not considered
+    size_t w = sim.width(v);
+    if (w) {
+      vars.push_back(v);
+      stats[v].ever_one.assign(w, false);
+      stats[v].ever_zero.assign(w, false);
+    }
+  }
+
+  bool observed = false;
+  for (unsigned int run = 0; run < sim_runs_; ++run) {
+    sim.reset();
+    for (unsigned int cyc = 0; cyc < sim_cycles_; ++cyc) {
+      if (cyc) {
+        sim.step();
+      }
+      uint64_t valid = sim.valid_lanes();
+      if (!valid) {
+        // every lane violated init or a constraint
+        break;
+      }
+      observed = true;
+
+      for (const auto & v : vars) {
+        const uint64_t * b = sim.bits(v);
+        size_t w = sim.width(v);
+        Stats & st = stats.at(v);
+        uint64_t seen = 0;
+        uint64_t two = 0;
+        for (size_t j = 0; j < w; ++j) {
+          uint64_t m = b[j] & valid;
+          st.sig ^= m + 0x9e3779b97f4a7c15ull + (st.sig << 6) + (st.sig >> 2);
+          st.ever_one[j] = st.ever_one[j] || m;
+          st.ever_zero[j] = st.ever_zero[j] || (~b[j] & valid);
+          two |= seen & m;
+          seen |= m;
+        }
+        st.multi_hot = st.multi_hot || two;
+
+        if (w <= 64) {
+          for (size_t l = 0; l < Simulator::num_lanes; ++l) {
+            if (!((valid >> l) & 1)) {
+              continue;
+            }
+            uint64_t val = 0;
+            for (size_t j = 0; j < w; ++j) {
+              val |= ((b[j] >> l) & 1) << j;
+            }
+            st.max = std::max(st.max, val);
+          }
+        }
+      }
+    }
+  }
+
+  TermVec res;
+  if (!observed) {
+    return res;
+  }
+
+  // binary string of a mask, most significant bit first
+  auto bin = [](const vector<bool> & bits) {
+    string s;
+    for (size_t j = bits.size(); j-- > 0;) {
+      s.push_back(bits[j] ? '1' : '0');
+    }
+    return s;
+  };
+
+  map<pair<string, uint64_t>, TermVec> groups;
+  for (const auto & v : vars) {
+    const Stats & st = stats.at(v);
+    Sort sort = v->get_sort();
+    size_t w = st.ever_one.size();
+
+    vector<bool> const_mask(w), const_val(w);
+    bool all_const = true;
+    bool some_const = false;
+    for (size_t j = 0; j < w; ++j) {
+      const_mask[j] = !st.ever_one[j] || !st.ever_zero[j];
+      const_val[j] = st.ever_one[j];
+      all_const = all_const && const_mask[j];
+      some_const = some_const || const_mask[j];
+    }
+
+    if (sort->get_sort_kind() == BOOL) {
+      if (all_const) {
+        res.push_back(const_val[0] ? v : ts_.make_term(Not, v));
+      } else {
+        groups[{ sort->to_string(), st.sig }].push_back(v);
+      }
+      continue;
+    }
+
+    if (all_const) {
+      res.push_back(
+          ts_.make_term(Equal, v, ts_.make_term(bin(const_val), sort, 2)));
+      continue;
+    }
+
+    groups[{ sort->to_string(), st.sig }].push_back(v);
+
+    if (some_const) {
+      // (v & mask) = val
+      Term mask = ts_.make_term(bin(const_mask), sort, 2);
+      Term val = ts_.make_term(bin(const_val), sort, 2);
+      res.push_back(ts_.make_term(Equal, ts_.make_term(BVAnd, v, mask), val));
+    }
+
+    if (w <= 64 && st.max < (w == 64 ? ~0ull : (1ull << w) - 1)) {
+      Term max = ts_.make_term(std::to_string(st.max), sort, 10);
+      res.push_back(ts_.make_term(BVUle, v, max));
+    }
+
+    if (w > 1 && !st.multi_hot) {
+      // at most one bit is set: (v & (v - 1)) = 0
+      Term one = ts_.make_term(1, sort);
+      Term vm1 = ts_.make_term(BVSub, v, one);
+      res.push_back(ts_.make_term(
+          Equal, ts_.make_term(BVAnd, v, vm1), ts_.make_term(0, sort)));
+    }
+  }
+
+  for (const auto & elem : groups) {
+    const TermVec & group = elem.second;
+    for (size_t i = 1; i < group.size(); ++i) {
+      res.push_back(ts_.make_term(Equal, group[0], group[i]));
+    }
+  }
+
+  return res;
+}
+
+TermVec InvariantMiner::mine() const
+{
+  TermVec cands = candidates();
+  logger.log(
+      1, "Invariant mining: {} candidates from simulation", cands.size());
+  if (cands.empty()) {
+    return cands;
+  }
+  TermVec res = inductive_subset(ts_, cands);
+  logger.log(1, "Invariant mining: proved {} invariants", res.size());
+  return res;
+}
+
+}  // namespace pono
@@ -0,0 +1,60 @@
+/*********************                                                        */
+/*! \file invariant_miner.h
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Cheap invariant mining for strengthening k-induction.
+**
+**        Candidate invariants are guessed from random simulation
+**        (starting in the initial states): constant state variables and
+**        bits, equal state variables, upper bounds and one-hot (or zero)
+**        bit-vectors. The largest inductive subset of the candidates is
+**        then proven with a Houdini-style fixpoint (see inductive_subset).
+**
+**/
+
+#pragma once
+
+#include "core/ts.h"
+
+namespace pono {
+
+class InvariantMiner
+{
+ public:
+  /** @param ts the transition system
+   *  @param sim_runs number of simulation runs (of Simulator::num_lanes
+   *         stimuli each)
+   *  @param sim_cycles number of cycles in each simulation run
+   *  @param seed the seed for the random stimuli
+   */
+  InvariantMiner(const TransitionSystem & ts,
+                 unsigned int sim_runs = 4,
+                 unsigned int sim_cycles = 64,
+                 unsigned int seed = 0);
+
+  /** @return candidate invariants over the state variables of ts
+   *          that held in every simulated state
+   *          (none if ts is not functional)
+   */
+  smt::TermVec candidates() const;
+
+  /** @return the candidates whose conjunction is an inductive invariant
+   *          (the largest such subset)
+   */
+  smt::TermVec mine() const;
+
+ protected:
+  const TransitionSystem & ts_;
+  unsigned int sim_runs_;
+  unsigned int sim_cycles_;
+  unsigned int seed_;
+};
+
+}  // namespace pono
@@ -0,0 +1,204 @@
+/*********************                                                        */
+/*! \file lemma_bus.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Lock-free bus for exchanging lemmas between engines running
+**        on different threads (and thus different solvers).
+**
+**
+**/
+
+#include "utils/lemma_bus.h"
+
+#include <unordered_map>
+
+#include "utils/exceptions.h"
+#include "utils/logger.h"
+
+using namespace smt;
+using namespace std;
+
+namespace pono {
+
+/** @return the name of a symbol, without the SMT-LIB |quotes|
+ *  i.e. the name it was created with and can be looked up by
+ */
+static string symbol_name(const Term & sym)
+{
+  string name = sym->to_string();
+  if (name.size() >= 2 && name.front() == '|' && name.back() == '|') {
+    name = name.substr(1, name.size() - 2);
+  }
+  return name;
+}
+
+LemmaBus::~LemmaBus()
+{
+  const Entry * e = head_.load();
+  while (e) {
+    const Entry * next = e->next;
+    delete e;
+    e = next;
+  }
+}
+
+bool LemmaBus::publish(size_t producer, const Term & lemma)
+{
+  Entry * e;
+  try {
+    e = new Entry{ encode(producer, lemma), nullptr };
+  }
+  catch (PonoException & ex) {
+    return false;
+  }
+
+  const Entry * old_head = head_.load();
+  do {
+    e->next = old_head;
+  } while (!head_.compare_exchange_weak(old_head, e));
+  size_++;
+  return true;
+}
+
+TermVec LemmaBus::fetch(size_t consumer,
+                        Cursor & cursor,
+                        const TransitionSystem & ts) const
+{
+  const Entry * new_head = head_.load();
+
+  // entries are linked newest first
+  vector<const Entry *> entries;
+  for (const Entry * e = new_head; e != cursor; e = e->next) {
+    if (e->lemma.producer != consumer) {
+      entries.push_back(e);
+    }
+  }
+  cursor = new_head;
+
+  TermVec res;
+  for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+    try {
+      res.push_back(decode((*it)->lemma, ts));
+    }
+    catch (std::exception & ex) {
+      // can't be expressed over this system, e.g. an abstraction variable
+      logger.log(2,
+                 "LemmaBus: dropping lemma from {} -- {}",
+                 (*it)->lemma.producer,
+                 ex.what());
+    }
+  }
+  return res;
+}
+
+Lemma LemmaBus::encode(size_t producer, const Term & t) const
+{
+  Lemma l;
+  l.producer = producer;
+
+  unordered_map<Term, size_t> cache;
+  TermVec to_visit({ t });
+  while (to_visit.size()) {
+    Term n = to_visit.back();
+
+    if (cache.find(n) != cache.end()) {
+      to_visit.pop_back();
+      continue;
+    }
+
+    LemmaNode ln;
+    Sort sort = n->get_sort();
+    ln.sk = sort->get_sort_kind();
+    ln.width = (ln.sk == BV) ? sort->get_width() : 0;
+
+    if (n->is_symbolic_const()) {
+      ln.kind = LemmaNode::SYMBOL;
+      ln.repr = symbol_name(n);
+    } else if (n->is_value()) {
+      if (ln.sk != BOOL && ln.sk != BV && ln.sk != INT && ln.sk != REAL) {
+        throw PonoException("Can't encode value of sort "
+                            + sort->to_string());
+      }
+      ln.kind = LemmaNode::VALUE;
+      ln.repr = n->to_string();
+    } else {
+      Op op = n->get_op();
+      if (op.is_null() || op.prim_op == Apply) {
+        throw PonoException("Can't encode term " + n->to_string());
+      }
+
+      bool children_done = true;
+      for (const auto & c : n) {
+        if (cache.find(c) == cache.end()) {
+          to_visit.push_back(c);
+          children_done = false;
+        }
+      }
+      if (!children_done) {
+        continue;
+      }
+
+      ln.kind = LemmaNode::APPLY;
+      ln.op = op;
+      for (const auto & c : n) {
+        ln.children.push_back(cache.at(c));
+      }
+    }
+
+    to_visit.pop_back();
+    cache[n] = l.nodes.size();
+    l.nodes.push_back(ln);
+  }
+
+  return l;
+}
+
+Term LemmaBus::decode(const Lemma & l, const TransitionSystem & ts) const
+{
+  const SmtSolver & solver = ts.solver();
+  TermVec built;
+  built.reserve(l.nodes.size());
+  for (const auto & ln : l.nodes) {
+    Term t;
+    if (ln.kind == LemmaNode::SYMBOL) {
+      t = ts.lookup(ln.repr);
+      if (!ts.is_curr_var(t)) {
+        throw PonoException("Lemma symbol " + ln.repr
+                            + " is not a state variable");
+      }
+    } else if (ln.kind == LemmaNode::VALUE) {
+      if (ln.sk == BOOL) {
+        t = solver->make_term(ln.repr == "true");
+      } else if (ln.sk == BV) {
+        Sort sort = solver->make_sort(BV, ln.width);
+        if (ln.repr.substr(0, 2) == "#b") {
+          t = solver->make_term(ln.repr.substr(2), sort, 2);
+        } else if (ln.repr.substr(0, 2) == "#x") {
+          t = solver->make_term(ln.repr.substr(2), sort, 16);
+        } else {
+          t = solver->make_term(ln.repr, sort);
+        }
+      } else {
+        t = solver->make_term(ln.repr, solver->make_sort(ln.sk));
+      }
+    } else {
+      TermVec children;
+      children.reserve(ln.children.size());
+      for (auto i : ln.children) {
+        children.push_back(built.at(i));
+      }
+      t = solver->make_term(ln.op, children);
+    }
+    built.push_back(t);
+  }
+  return built.back();
+}
+
+}  // namespace pono
@@ -0,0 +1,123 @@
+/*********************                                                        */
+/*! \file lemma_bus.h
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Lock-free bus for exchanging lemmas between engines running
+**        on different threads (and thus different solvers).
+**
+**        Terms cannot be read from another thread's solver, so a lemma
+**        is encoded into a solver-independent form by the producer
+**        (on its own thread) and rebuilt in the consumer's solver
+**        by the consumer. Symbols are matched by name.
+**
+**        The bus is an append-only singly-linked list with an atomic
+**        head. Entries are never removed while the bus is alive, so
+**        consumers can hold on to a cursor without synchronization.
+**
+**/
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "core/ts.h"
+#include "smt-switch/smt.h"
+
+namespace pono {
+
+/** A single node of an encoded lemma
+ *  The nodes of a lemma are stored in post-order, so
+ *  children always refer to earlier nodes
+ */
+struct LemmaNode
+{
+  enum Kind
+  {
+    SYMBOL = 0,
+    VALUE,
+    APPLY
+  };
+
+  Kind kind;
+  std::string repr;  ///< symbol name or value string
+  smt::SortKind sk;  ///< sort kind of a value
+  uint64_t width;    ///< bit-width of a bit-vector value
+  smt::Op op;        ///< operator of an application
+  std::vector<size_t> children;  ///< indices of children (post-order)
+};
+
+/** A solver-independent lemma over current state variables */
+struct Lemma
+{
+  size_t producer;  ///< id of the engine that published this lemma
+  std::vector<LemmaNode> nodes;  ///< the root is the last node
+};
+
+class LemmaBus
+{
+ public:
+  struct Entry
+  {
+    Lemma lemma;
+    const Entry * next;
+  };
+
+  /** Cursor into the bus -- the newest entry a consumer has seen */
+  typedef const Entry * Cursor;
+
+  LemmaBus() : head_(nullptr), size_(0) {}
+  ~LemmaBus();
+
+  LemmaBus(const LemmaBus &) = delete;
+  LemmaBus & operator=(const LemmaBus &) = delete;
+
+  /** Publish a lemma
+   *  Must be called from the thread that owns lemma's solver
+   *  Lemmas containing anything that cannot be encoded
+   *  (e.g. array values or uninterpreted functions) are silently dropped
+   *  @param producer id of the publishing engine
+   *  @param lemma a boolean term over current state variables
+   *  @return true iff the lemma was published
+   */
+  bool publish(size_t producer, const smt::Term & lemma);
+
+  /** Fetch lemmas published by other engines since the cursor
+   *  Must be called from the thread that owns ts's solver
+   *  Lemmas that cannot be rebuilt over the state variables
+   *  of ts are skipped
+   *  @param consumer id of the fetching engine (its own lemmas are skipped)
+   *  @param cursor the consumer's cursor, updated to the newest entry
+   *  @param ts the consumer's transition system
+   *  @return the new lemmas as terms in ts's solver, oldest first
+   */
+  smt::TermVec fetch(size_t consumer,
+                     Cursor & cursor,
+                     const TransitionSystem & ts) const;
+
+  /** @return the number of lemmas published so far */
+  size_t size() const { return size_; }
+
+ protected:
+  /** Encode a term into a Lemma
+   *  throws a PonoException if the term cannot be encoded
+   */
+  Lemma encode(size_t producer, const smt::Term & t) const;
+
+  /** Rebuild a Lemma in the solver of ts
+   *  throws an exception if it cannot be rebuilt
+   */
+  smt::Term decode(const Lemma & l, const TransitionSystem & ts) const;
+
+  std::atomic<const Entry *> head_;
+  std::atomic<size_t> size_;
+};
+
+}  // namespace pono
@@ -20,8 +20,11 @@
 #include "engines/bmc_simplepath.h"
 #include "engines/ic3ia.h"
 #include "engines/interpolantmc.h"
+#include "engines/interpseqmc.h"
 #include "engines/kinduction.h"
 #include "engines/mbic3.h"
+#include "engines/portfolio.h"
+#include "engines/random_sim.h"
 #ifdef WITH_MSAT_IC3IA
 #include "engines/msat_ic3ia.h"
 #endif
@@ -54,6 +57,15 @@ shared_ptr<Prover> make_prover(Engine e,
 #else
     throw PonoException(
         "Interpolant-based modelchecking requires an interpolator");
+#endif
+  } else if (e == ISB) {
+#ifdef WITH_MSAT
+    SmtSolver s = create_interpolating_solver(SolverEnum::MSAT_INTERPOLATOR);
+    return make_prover(e, p, ts, slv, s, opts);
+#else
+    throw PonoException(
+        "Interpolation-sequence based modelchecking requires an "
+        "interpolator");
 #endif
   } else if (e == MBIC3) {
     return make_shared<ModelBasedIC3>(p, ts, slv, opts);
@@ -69,6 +81,10 @@ shared_ptr<Prover> make_prover(Engine e,
   } else if (e == MSAT_IC3IA) {
     return make_shared<MsatIC3IA>(p, ts, slv, opts);
 #endif
+  } else if (e == PORTFOLIO) {
+    return make_shared<Portfolio>(p, ts, slv, opts);
+  } else if (e == SIM) {
+    return make_shared<RandomSimulation>(p, ts, slv, opts);
   } else {
     throw PonoException("Unhandled engine");
   }
@@ -83,6 +99,8 @@ shared_ptr<Prover> make_prover(Engine e,
 {
   if (e == INTERP) {
     return make_shared<InterpolantMC>(p, ts, slv, itp, opts);
+  } else if (e == ISB) {
+    return make_shared<InterpSeqMC>(p, ts, slv, itp, opts);
   } else if (e == IC3IA_ENGINE) {
     return make_shared<IC3IA>(p, ts, slv, itp, opts);
   } else {
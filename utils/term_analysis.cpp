@@ -270,4 +270,55 @@ void get_predicates(const SmtSolver & solver,
   }
 }
 
+vector<bool> value_bits(const Term & val, size_t width)
+{
+  string s = val->to_string();
+  vector<bool> bits(width, false);
+  if (s == "true" || s == "false") {
+    bits[0] = (s == "true");
+    return bits;
+  }
+
+  if (s.substr(0, 2) == "#b") {
+    s = s.substr(2);
+    for (size_t i = 0; i < s.size() && i < width; ++i) {
+      bits[i] = (s[s.size() - 1 - i] == '1');
+    }
+    return bits;
+  } else if (s.substr(0, 2) == "#x") {
+    s = s.substr(2);
+    for (size_t i = 0; i < s.size(); ++i) {
+      char ch = s[s.size() - 1 - i];
+      int nibble = isdigit(ch) ? ch - '0' : tolower(ch) - 'a' + 10;
+      for (size_t k = 0; k < 4 && 4 * i + k < width; ++k) {
+        bits[4 * i + k] = (nibble >> k) & 1;
+      }
+    }
+    return bits;
+  }
+
+  // decimal, possibly as (_ bvN w)
+  if (s.substr(0, 5) == "(_ bv") {
+    s = s.substr(5, s.find(' ', 5) - 5);
+  }
+  if (s.empty() || s.find_first_not_of("0123456789") != string::npos) {
+    throw PonoException("Can't interpret value " + val->to_string());
+  }
+  // repeated division by two of the decimal string
+  for (size_t i = 0; i < width && s != "0"; ++i) {
+    string quot;
+    int rem = 0;
+    for (char ch : s) {
+      int cur = rem * 10 + (ch - '0');
+      if (!quot.empty() || cur / 2) {
+        quot.push_back('0' + cur / 2);
+      }
+      rem = cur % 2;
+    }
+    bits[i] = rem;
+    s = quot.empty() ? "0" : quot;
+  }
+  return bits;
+}
+
 }  // namespace pono
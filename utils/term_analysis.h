@@ -63,4 +63,12 @@ void get_predicates(const smt::SmtSolver & solver,
                     smt::UnorderedTermSet & out,
                     bool include_symbols = false);
 
+/** Get the bits of a boolean or bit-vector value
+ *  @param val the value (as returned by get_value or a constant)
+ *  @param width the number of bits (1 for booleans)
+ *  @return the bits, least significant first
+ *  throws a PonoException if the value can't be interpreted
+ */
+std::vector<bool> value_bits(const smt::Term & val, size_t width);
+
 }  // namespace pono
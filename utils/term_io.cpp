@@ -0,0 +1,282 @@
+/*********************                                                        */
+/*! \file term_io.cpp
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Solver-independent SMT-LIB printing and parsing of terms over
+**        the state variables of a transition system.
+**
+**
+**/
+
+#include "utils/term_io.h"
+
+#include <cctype>
+#include <unordered_map>
+
+#include "utils/exceptions.h"
+#include "utils/term_analysis.h"
+
+using namespace smt;
+using namespace std;
+
+namespace pono {
+
+/** @return true iff name needs |quotes| to be a single SMT-LIB token */
+static bool needs_quotes(const string & name)
+{
+  if (name.empty() || (name.front() == '|' && name.back() == '|')) {
+    return false;
+  }
+  for (char ch : name) {
+    if (isspace(ch) || ch == '(' || ch == ')' || ch == ';' || ch == '"') {
+      return true;
+    }
+  }
+  return false;
+}
+
+static string value_to_smtlib(const Term & t)
+{
+  Sort sort = t->get_sort();
+  SortKind sk = sort->get_sort_kind();
+  string s = t->to_string();
+  if (sk == BOOL) {
+    // some solvers represent booleans as bit-vectors of width one
+    if (s == "#b1" || s == "#b0") {
+      return s == "#b1" ? "true" : "false";
+    } else if (s != "true" && s != "false") {
+      throw PonoException("Can't print boolean value " + s);
+    }
+    return s;
+  } else if (sk == BV) {
+    size_t w = sort->get_width();
+    vector<bool> bits = value_bits(t, w);
+    string res = "#b";
+    for (size_t j = w; j-- > 0;) {
+      res.push_back(bits[j] ? '1' : '0');
+    }
+    return res;
+  } else if (sk == INT) {
+    // negative values are printed as a single token, e.g. -5
+    if (s.substr(0, 3) == "(- " && s.back() == ')') {
+      s = "-" + s.substr(3, s.size() - 4);
+    }
+    return s;
+  }
+  throw PonoException("Can't print value of sort " + sort->to_string());
+}
+
+string term_to_smtlib(const Term & t)
+{
+  if (t->is_symbolic_const()) {
+    string name = t->to_string();
+    return needs_quotes(name) ? "|" + name + "|" : name;
+  } else if (t->is_value()) {
+    return value_to_smtlib(t);
+  }
+
+  Op op = t->get_op();
+  if (op.is_null() || op.prim_op == Apply) {
+    throw PonoException("Can't print term " + t->to_string());
+  }
+  string res = "(" + op.to_string();
+  for (const auto & c : t) {
+    res += " " + term_to_smtlib(c);
+  }
+  return res + ")";
+}
+
+/** A recursive descent parser for the output of term_to_smtlib */
+class SmtLibTermParser
+{
+ public:
+  SmtLibTermParser(const string & s, const TransitionSystem & ts)
+      : s_(s), pos_(0), ts_(ts), solver_(ts.solver())
+  {
+  }
+
+  Term parse()
+  {
+    Term res = parse_term();
+    skip_space();
+    if (pos_ != s_.size()) {
+      error("trailing characters");
+    }
+    return res;
+  }
+
+ protected:
+  void error(const string & msg) const
+  {
+    throw PonoException("Can't parse term at position " + std::to_string(pos_)
+                        + " (" + msg + "): " + s_);
+  }
+
+  void skip_space()
+  {
+    while (pos_ < s_.size() && isspace(s_[pos_])) {
+      ++pos_;
+    }
+  }
+
+  void expect(char ch)
+  {
+    skip_space();
+    if (pos_ >= s_.size() || s_[pos_] != ch) {
+      error(string("expected ") + ch);
+    }
+    ++pos_;
+  }
+
+  bool at(char ch)
+  {
+    skip_space();
+    return pos_ < s_.size() && s_[pos_] == ch;
+  }
+
+  /** @return the next atom (a |quoted| symbol keeps its quotes) */
+  string atom()
+  {
+    skip_space();
+    size_t start = pos_;
+    if (pos_ < s_.size() && s_[pos_] == '|') {
+      size_t end = s_.find('|', pos_ + 1);
+      if (end == string::npos) {
+        error("unterminated |symbol|");
+      }
+      pos_ = end + 1;
+    } else {
+      while (pos_ < s_.size() && !isspace(s_[pos_]) && s_[pos_] != '('
+             && s_[pos_] != ')') {
+        ++pos_;
+      }
+    }
+    if (start == pos_) {
+      error("expected an atom");
+    }
+    return s_.substr(start, pos_ - start);
+  }
+
+  PrimOp prim_op(const string & name) const
+  {
+    const unordered_map<string, PrimOp> & ops = prim_ops();
+    auto it = ops.find(name);
+    if (it == ops.end()) {
+      error("unknown operator " + name);
+    }
+    return it->second;
+  }
+
+  uint64_t index()
+  {
+    string a = atom();
+    if (a.find_first_not_of("0123456789") != string::npos) {
+      error("expected an index");
+    }
+    return stoull(a);
+  }
+
+  Term parse_atom(const string & a)
+  {
+    if (a == "true" || a == "false") {
+      return solver_->make_term(a == "true");
+    } else if (a.substr(0, 2) == "#b") {
+      Sort sort = solver_->make_sort(BV, a.size() - 2);
+      return solver_->make_term(a.substr(2), sort, 2);
+    } else if (a.substr(0, 2) == "#x") {
+      Sort sort = solver_->make_sort(BV, 4 * (a.size() - 2));
+      return solver_->make_term(a.substr(2), sort, 16);
+    } else if (isdigit(a[0]) || (a[0] == '-' && a.size() > 1)) {
+      return solver_->make_term(a, solver_->make_sort(INT));
+    }
+
+    // a symbol, matched by name
+    Term t;
+    try {
+      t = ts_.lookup(a);
+    }
+    catch (PonoException & e) {
+      if (a.size() < 2 || a.front() != '|') {
+        throw;
+      }
+      t = ts_.lookup(a.substr(1, a.size() - 2));
+    }
+    if (!ts_.is_curr_var(t)) {
+      error(a + " is not a state variable");
+    }
+    return t;
+  }
+
+  Term parse_term()
+  {
+    if (!at('(')) {
+      return parse_atom(atom());
+    }
+    expect('(');
+
+    Op op;
+    if (at('(')) {
+      // indexed operator (_ name i [j])
+      expect('(');
+      if (atom() != "_") {
+        error("expected _");
+      }
+      PrimOp po = prim_op(atom());
+      uint64_t idx0 = index();
+      if (at(')')) {
+        op = Op(po, idx0);
+      } else {
+        op = Op(po, idx0, index());
+      }
+      expect(')');
+    } else {
+      op = Op(prim_op(atom()));
+    }
+
+    TermVec children;
+    while (!at(')')) {
+      if (pos_ >= s_.size()) {
+        error("expected )");
+      }
+      children.push_back(parse_term());
+    }
+    expect(')');
+    return solver_->make_term(op, children);
+  }
+
+  const string & s_;
+  size_t pos_;
+  const TransitionSystem & ts_;
+  SmtSolver solver_;
+
+  /** @return the operators by name
+   *  built once, thread-safe (parsers run in the portfolio workers)
+   */
+  static const unordered_map<string, PrimOp> & prim_ops()
+  {
+    static const unordered_map<string, PrimOp> ops = []() {
+      unordered_map<string, PrimOp> res;
+      for (int i = 0; i < NUM_OPS_AND_NULL; ++i) {
+        PrimOp po = static_cast<PrimOp>(i);
+        res[smt::to_string(po)] = po;
+      }
+      return res;
+    }();
+    return ops;
+  }
+};
+
+Term smtlib_to_term(const string & s, const TransitionSystem & ts)
+{
+  SmtLibTermParser parser(s, ts);
+  return parser.parse();
+}
+
+}  // namespace pono
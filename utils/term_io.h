@@ -0,0 +1,48 @@
+/*********************                                                        */
+/*! \file term_io.h
+** \verbatim
+** Top contributors (to current version):
+**   Makai Mann, Ahmed Irfan
+** This file is part of the pono project.
+** Copyright (c) 2026 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved.  See the file LICENSE in the top-level source
+** directory for licensing information.\endverbatim
+**
+** \brief Solver-independent SMT-LIB printing and parsing of terms over
+**        the state variables of a transition system (e.g. to store lemmas
+**        in a file).
+**
+**        Only symbols, boolean, bit-vector and integer values, and builtin
+**        operators are supported. Symbols are matched by name, like in the
+**        lemma bus.
+**
+**/
+
+#pragma once
+
+#include <string>
+
+#include "core/ts.h"
+
+namespace pono {
+
+/** Print a term as an SMT-LIB s-expression (without let bindings)
+ *  throws a PonoException if the term contains unsupported values
+ *  or operators (e.g. uninterpreted functions)
+ *  @param t the term
+ *  @return the s-expression
+ */
+std::string term_to_smtlib(const smt::Term & t);
+
+/** Parse an s-expression printed by term_to_smtlib
+ *  throws a PonoException if it can't be parsed or a symbol is
+ *  not a current state variable of ts
+ *  @param s the s-expression
+ *  @param ts the transition system to look up symbols in, the result is
+ *         built in its solver
+ *  @return the term
+ */
+smt::Term smtlib_to_term(const std::string & s, const TransitionSystem & ts);
+
+}  // namespace pono
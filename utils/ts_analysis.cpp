@@ -17,6 +17,7 @@
 #include "smt-switch/term_translator.h"
 
 #include "smt/available_solvers.h"
+#include "utils/exceptions.h"
 #include "utils/logger.h"
 #include "utils/ts_analysis.h"
 
@@ -75,4 +76,80 @@ bool check_invar(const TransitionSystem & ts,
   return pass;
 }
 
+TermVec inductive_subset(const TransitionSystem & ts,
+                         const TermVec & conjuncts)
+{
+  // use a fresh solver, like check_invar
+  SmtSolver solver = create_solver(ts.solver()->get_solver_enum());
+  solver->set_opt("incremental", "true");
+  solver->set_opt("produce-models", "true");
+  TermTranslator tt(solver);
+  Term false_ = solver->make_term(false);
+
+  TermVec curr, next;
+  for (const auto & c : conjuncts) {
+    if (!ts.only_curr(c)) {
+      throw PonoException("Expecting only current state variables in "
+                          + c->to_string());
+    }
+    curr.push_back(tt.transfer_term(c, BOOL));
+    next.push_back(tt.transfer_term(ts.next(c), BOOL));
+  }
+
+  std::vector<bool> keep(conjuncts.size(), true);
+  // drops the kept conjuncts (in vals) that are false in a model
+  // of the assertions and the negation of their conjunction
+  // until there's no model
+  auto drop_until_unsat = [&](const TermVec & vals, bool assume_curr) {
+    while (true) {
+      solver->push();
+      Term some_false = false_;
+      for (size_t i = 0; i < vals.size(); ++i) {
+        if (keep[i]) {
+          if (assume_curr) {
+            solver->assert_formula(curr[i]);
+          }
+          Term not_val = solver->make_term(Not, vals[i]);
+          some_false = solver->make_term(Or, some_false, not_val);
+        }
+      }
+      solver->assert_formula(some_false);
+      Result r = solver->check_sat();
+      if (r.is_sat()) {
+        for (size_t i = 0; i < vals.size(); ++i) {
+          if (keep[i] && solver->get_value(vals[i]) == false_) {
+            keep[i] = false;
+          }
+        }
+      } else if (r.is_unknown()) {
+        keep.assign(keep.size(), false);
+      }
+      solver->pop();
+      if (!r.is_sat()) {
+        return;
+      }
+    }
+  };
+
+  solver->push();
+  solver->assert_formula(tt.transfer_term(ts.init(), BOOL));
+  drop_until_unsat(curr, false);
+  solver->pop();
+
+  solver->assert_formula(tt.transfer_term(ts.trans(), BOOL));
+  drop_until_unsat(next, true);
+
+  TermVec res;
+  for (size_t i = 0; i < conjuncts.size(); ++i) {
+    if (keep[i]) {
+      res.push_back(conjuncts[i]);
+    }
+  }
+  logger.log(1,
+             "INVARCHECK: kept {} of {} conjuncts as an inductive invariant",
+             res.size(),
+             conjuncts.size());
+  return res;
+}
+
 }  // namespace pono
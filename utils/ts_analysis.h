@@ -34,4 +34,16 @@ bool check_invar(const TransitionSystem & ts,
                  const smt::Term & prop,
                  const smt::Term & invar);
 
+/** Finds the largest subset of the given conjuncts whose conjunction
+ *  is an inductive invariant of the system (Houdini-style)
+ *  Conjuncts that don't hold initially are dropped, then the
+ *  conjuncts that are falsified in the next state of a
+ *  counterexample to induction are dropped until none is left
+ *  @param ts the transition system
+ *  @param conjuncts boolean terms over current state variables
+ *  @return the conjuncts that are kept, in their original order
+ */
+smt::TermVec inductive_subset(const TransitionSystem & ts,
+                              const smt::TermVec & conjuncts);
+
 }  // namespace pono